@@ -20,6 +20,7 @@ static physics::Simulation* g_sim       = nullptr;
 static engine::Camera*      g_camera    = nullptr;
 static ui::PeriodicTableUI* g_ptUI      = nullptr;
 static int g_windowW = 1280, g_windowH = 720;
+static uint64_t g_lastLogSeq = 0;           // next reaction-log entry to print
 
 static void keyCallback(GLFWwindow* win, int key, int, int action, int) {
     if (action != GLFW_PRESS) return;
@@ -33,7 +34,16 @@ static void keyCallback(GLFWwindow* win, int key, int, int action, int) {
                               std::cout << "[Temp] " << inter.temperature << "K\n"; break;
         case GLFW_KEY_DOWN:   inter.temperature = std::max(inter.temperature - 100.0f, 10.0f);
                               std::cout << "[Temp] " << inter.temperature << "K\n"; break;
-        case GLFW_KEY_DELETE: g_sim->clear(); break;
+        case GLFW_KEY_DELETE: g_sim->clear();
+                              g_lastLogSeq = g_sim->reactionLog().total(); break;
+        case GLFW_KEY_B: {
+            using Boundary = physics::Simulation::Boundary;
+            g_sim->boundary = (g_sim->boundary == Boundary::Periodic) ? Boundary::Reflective
+                                                                      : Boundary::Periodic;
+            std::cout << "[Boundary] "
+                      << (g_sim->boundary == Boundary::Periodic ? "periodic" : "reflective") << "\n";
+            break;
+        }
         // Quick spawn shortcuts
         case GLFW_KEY_1: g_sim->spawnAtom(1,  glm::vec3(0)); break; // H
         case GLFW_KEY_2: g_sim->spawnAtom(2,  glm::vec3(0)); break; // He
@@ -92,21 +102,22 @@ int main() {
     glfwSetMouseButtonCallback(eng.getWindow(), mouseButtonCallback);
 
     // Starter atoms (let's form a water molecule and some salt)
-    sim.spawnAtom(8, glm::vec3(0, 0, 0));    // O
-    sim.spawnAtom(1, glm::vec3(1.5, 1, 0));  // H
-    sim.spawnAtom(1, glm::vec3(-1.5, 1, 0)); // H
-
-    sim.spawnAtom(11, glm::vec3(5, -5, 0));  // Na
-    sim.spawnAtom(17, glm::vec3(6, -5, 0));  // Cl
+    sim.spawnAtoms({
+        {8,  glm::vec3(0, 0, 0)},            // O
+        {1,  glm::vec3(1.5, 1, 0)},          // H
+        {1,  glm::vec3(-1.5, 1, 0)},         // H
+        {11, glm::vec3(5, -5, 0)},           // Na
+        {17, glm::vec3(6, -5, 0)},           // Cl
+    });
 
     std::cout << "\n=== Universal Simulator ===\n"
               << "Physics: Velocity Verlet (eV, Å, amu, fs)\n"
               << "Chemistry: Emergent (Morse bonds, Born-Haber ionic, VSEPR angles)\n"
-              << "Controls: Tab to toggle PT, 1-8 for presets, Up/Down for temp.\n\n";
+              << "Controls: Tab to toggle PT, 1-8 for presets, Up/Down for temp, B for boundary.\n\n";
 
     float fpsTimer = 0, frameCount = 0, fps = 0;
-    float physDt = 1.0f; // 1 fs integration step
-    int lastLogCount = 0;
+    float physDt = 1.0f; // 1 fs integration step (seeds the adaptive controller)
+    sim.adaptiveDt = true;
     std::string latestReaction = "";
 
     while (eng.isRunning()) {
@@ -121,7 +132,7 @@ int main() {
             
             // Console print high-level stats every second
             const auto& mols = sim.molecules();
-            if (!mols.empty() && mols.size() < sim.atoms().size()) {
+            if (!mols.empty() && static_cast<int>(mols.size()) < sim.atoms().size()) {
                 std::cout << "[Molecules] ";
                 for (const auto& m : mols) if (m.atomIndices.size() > 1) std::cout << m.formula << " ";
                 std::cout << "\n";
@@ -137,33 +148,42 @@ int main() {
 
         // Print new reactions
         const auto& logs = sim.reactionLog();
-        if (logs.size() > lastLogCount) {
-            for (size_t i = lastLogCount; i < logs.size(); ++i) {
-                std::cout << "[Reaction] " << std::fixed << std::setprecision(1) 
-                          << logs[i].time << "fs: " << logs[i].description << "\n";
-                latestReaction = logs[i].description;
+        if (logs.total() > g_lastLogSeq) {
+            if (g_lastLogSeq < logs.first()) {
+                std::cout << "[Reaction] ... " << (logs.first() - g_lastLogSeq)
+                          << " earlier events dropped\n";
+                g_lastLogSeq = logs.first();
+            }
+            for (uint64_t seq = g_lastLogSeq; seq < logs.total(); ++seq) {
+                const auto& e = logs.at(seq);
+                std::cout << "[Reaction] " << std::fixed << std::setprecision(1)
+                          << e.time << "fs: " << physics::ReactionLog::format(e) << "\n";
             }
-            lastLogCount = logs.size();
+            if (!logs.empty()) latestReaction = physics::ReactionLog::format(logs.latest());
+            g_lastLogSeq = logs.total();
         }
 
         // --- Render Data ---
         const auto& atoms = sim.atoms();
         std::vector<engine::SphereInstance> spheres;
-        for (const auto& a : atoms) {
+        for (int i = 0; i < atoms.size(); ++i) {
             engine::SphereInstance s;
-            s.position = a.pos;
-            s.radius = a.visualRadius;
-            s.color = glm::vec4(a.element->color, 1.0f);
+            s.position = atoms.pos(i);
+            s.radius = atoms[i].visualRadius;
+            s.color = glm::vec4(atoms[i].element->color, 1.0f);
             spheres.push_back(s);
         }
 
+        // Bonds across a periodic face are drawn to the partner's nearest image
+        const physics::Box box = sim.box();
         std::vector<engine::BondInstance> bondInstances;
-        for (size_t i = 0; i < atoms.size(); ++i) {
-            for (const auto& b : atoms[i].bonds) {
-                if (b.otherAtomIdx > static_cast<int>(i)) {
+        for (int i = 0; i < atoms.size(); ++i) {
+            for (const auto& e : atoms.bonds().of(i)) {
+                if (e.otherAtomIdx > i) {
+                    const physics::Bond& b = atoms.bonds()[e.bond];
                     engine::BondInstance bi;
-                    bi.posA = atoms[i].pos;
-                    bi.posB = atoms[b.otherAtomIdx].pos;
+                    bi.posA = atoms.pos(i);
+                    bi.posB = bi.posA + box.delta(atoms.pos(e.otherAtomIdx), bi.posA);
                     bi.thickness = 0.1f * b.order;
                     if (b.type == physics::Bond::IONIC)
                         bi.color = glm::vec4(1.0f, 0.8f, 0.2f, 1.0f); // Gold = Ionic
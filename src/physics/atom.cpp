@@ -8,16 +8,13 @@ void Atom::init(int atomicNumber) {
     element = &PeriodicTable::instance().get(atomicNumber);
     electrons = fillElectronShells(atomicNumber);
     charge = 0;
-    mass = element->atomicMass;
     visualRadius = element->atomicRadius / 100.0f; // pm → Å scale
     if (visualRadius < 0.5f) visualRadius = 0.5f;
     updateEffectiveValence();
 }
 
 int Atom::totalBondOrder() const {
-    int total = 0;
-    for (const auto& b : bonds) total += b.order;
-    return total;
+    return bondOrder;
 }
 
 int Atom::availableValenceElectrons() const {
@@ -32,15 +29,11 @@ void Atom::updateEffectiveValence() {
 }
 
 bool Atom::wantsElectron() const {
-    if (!element) return false;
-    return element->electronAffinity > 0.3f &&
-           element->valenceElectrons < 8;
+    return element && (element->traits & WantsElectron);
 }
 
 bool Atom::wantsToLoseElectron() const {
-    if (!element) return false;
-    return element->ionizationEnergy < 8.0f &&
-           element->valenceElectrons <= 2;
+    return element && !electrons.empty() && (element->traits & LosesElectron);
 }
 
 Electron Atom::removeOuterElectron() {
@@ -0,0 +1,92 @@
+#include "atom_store.h"
+#include <algorithm>
+
+namespace physics {
+
+int AtomStore::add(const Atom& atom, glm::vec3 pos, glm::vec3 vel) {
+    float m = atom.element ? atom.element->atomicMass : 1.0f;
+    records_.push_back(atom);
+    x.push_back(pos.x);  y.push_back(pos.y);  z.push_back(pos.z);
+    vx.push_back(vel.x); vy.push_back(vel.y); vz.push_back(vel.z);
+    fx.push_back(0.0f);  fy.push_back(0.0f);  fz.push_back(0.0f);
+    mass.push_back(m);
+    invMass.push_back(m > 0 ? 1.0f / m : 0.0f);
+    type.push_back(atom.elementZ);
+    imageX.push_back(0); imageY.push_back(0); imageZ.push_back(0);
+    bonds_.addAtom();
+    ids_.push_back(static_cast<int>(indexOf_.size()));
+    indexOf_.push_back(size() - 1);
+    return size() - 1;
+}
+
+void AtomStore::clear() {
+    records_.clear();
+    bonds_.clear();
+    ids_.clear();
+    std::fill(indexOf_.begin(), indexOf_.end(), -1);   // IDs are not reused
+    for (auto* v : {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &mass, &invMass})
+        v->clear();
+    for (auto* v : {&type, &imageX, &imageY, &imageZ})
+        v->clear();
+}
+
+void AtomStore::reserve(int n) {
+    records_.reserve(n);
+    ids_.reserve(n);
+    for (auto* v : {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &mass, &invMass})
+        v->reserve(n);
+    for (auto* v : {&type, &imageX, &imageY, &imageZ})
+        v->reserve(n);
+}
+
+template <typename T>
+static void gather(std::vector<T>& v, const std::vector<int>& order, std::vector<T>& scratch) {
+    scratch.resize(order.size());
+    for (size_t k = 0; k < order.size(); ++k) scratch[k] = std::move(v[order[k]]);
+    v.swap(scratch);
+}
+
+std::vector<int> AtomStore::reorder(const std::vector<int>& order) {
+    int n = size();
+    std::vector<int> newIndex(n, -1);
+    for (size_t k = 0; k < order.size(); ++k) newIndex[order[k]] = static_cast<int>(k);
+    for (int i = 0; i < n; ++i) {
+        if (newIndex[i] >= 0) continue;
+        indexOf_[ids_[i]] = -1;
+        for (const auto& e : bonds_.of(i))          // partners lose the bond
+            records_[e.otherAtomIdx].bondOrder -= bonds_[e.bond].order;
+    }
+
+    std::vector<float> floatScratch;
+    for (auto* v : {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &mass, &invMass})
+        gather(*v, order, floatScratch);
+    std::vector<int> intScratch;
+    for (auto* v : {&type, &imageX, &imageY, &imageZ, &ids_})
+        gather(*v, order, intScratch);
+    std::vector<Atom> recordScratch;
+    gather(records_, order, recordScratch);
+    for (int k = 0; k < size(); ++k) indexOf_[ids_[k]] = k;
+    bonds_.remap(order, newIndex);
+    return newIndex;
+}
+
+int AtomStore::addBond(const Bond& bond) {
+    records_[bond.atomA].bondOrder += bond.order;
+    records_[bond.atomB].bondOrder += bond.order;
+    return bonds_.add(bond);
+}
+
+void AtomStore::removeBond(int slot) {
+    const Bond& bond = bonds_[slot];
+    records_[bond.atomA].bondOrder -= bond.order;
+    records_[bond.atomB].bondOrder -= bond.order;
+    bonds_.remove(slot);
+}
+
+void AtomStore::clearForces() {
+    std::fill(fx.begin(), fx.end(), 0.0f);
+    std::fill(fy.begin(), fy.end(), 0.0f);
+    std::fill(fz.begin(), fz.end(), 0.0f);
+}
+
+} // namespace physics
@@ -0,0 +1,85 @@
+#pragma once
+#include "atom.h"
+#include "bond_table.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace physics {
+
+/// Structure-of-arrays atom storage.
+/// Kinematic state touched every step (position, velocity, force, mass)
+/// lives in contiguous per-component arrays for the integrator and pair
+/// kernels. Identity, electrons, bonds and visuals stay in the Atom
+/// records, reached through operator[] and iteration.
+///
+/// Indices change when atoms are removed or reordered; each atom also has
+/// a stable ID, never reused, for references that must survive that.
+class AtomStore {
+public:
+    /// Append an initialised atom. Returns its index.
+    int add(const Atom& atom, glm::vec3 pos, glm::vec3 vel = glm::vec3(0.0f));
+
+    void clear();
+    void reserve(int n);
+    int  size()  const { return static_cast<int>(records_.size()); }
+    bool empty() const { return records_.empty(); }
+
+    // ── Stable IDs ──
+    int id(int i) const { return ids_[i]; }
+    /// Current index of an atom ID, or -1 if it was removed.
+    int indexOf(int id) const {
+        return id >= 0 && id < static_cast<int>(indexOf_.size()) ? indexOf_[id] : -1;
+    }
+
+    /// Rearrange the atoms so new index k holds old index order[k]; atoms
+    /// not listed are removed. Bond partners are rewritten to the new
+    /// indices and bonds to removed atoms dropped. Returns the old → new
+    /// index map (-1 for removed atoms).
+    std::vector<int> reorder(const std::vector<int>& order);
+
+    // ── Bonds ──
+    const BondTable& bonds() const { return bonds_; }
+    /// Add a bond (endpoints in bond.atomA/atomB). Returns its table slot.
+    int addBond(const Bond& bond);
+    /// Remove the bond in a table slot.
+    void removeBond(int slot);
+
+    // ── Cold data (identity, electrons, bonds, visuals) ──
+    Atom&       operator[](int i)       { return records_[i]; }
+    const Atom& operator[](int i) const { return records_[i]; }
+    std::vector<Atom>::iterator       begin()       { return records_.begin(); }
+    std::vector<Atom>::iterator       end()         { return records_.end(); }
+    std::vector<Atom>::const_iterator begin() const { return records_.begin(); }
+    std::vector<Atom>::const_iterator end()   const { return records_.end(); }
+
+    // ── Hot data accessors ──
+    glm::vec3 pos(int i)   const { return glm::vec3(x[i], y[i], z[i]); }
+    glm::vec3 vel(int i)   const { return glm::vec3(vx[i], vy[i], vz[i]); }
+    glm::vec3 force(int i) const { return glm::vec3(fx[i], fy[i], fz[i]); }
+    /// Position with periodic wraps undone (continuous trajectory).
+    glm::vec3 unwrappedPos(int i, float boxLength) const {
+        return pos(i) + boxLength * glm::vec3(imageX[i], imageY[i], imageZ[i]);
+    }
+    void setPos(int i, glm::vec3 p) { x[i] = p.x;  y[i] = p.y;  z[i] = p.z; }
+    void setVel(int i, glm::vec3 v) { vx[i] = v.x; vy[i] = v.y; vz[i] = v.z; }
+    void addForce(int i, glm::vec3 f) { fx[i] += f.x; fy[i] += f.y; fz[i] += f.z; }
+
+    /// Zero all force components.
+    void clearForces();
+
+    // ── Hot data (SoA) ──
+    std::vector<float> x, y, z;        // Å
+    std::vector<float> vx, vy, vz;     // Å/fs
+    std::vector<float> fx, fy, fz;     // eV/Å
+    std::vector<float> mass, invMass;  // amu, 1/amu (0 for massless)
+    std::vector<int>   type;           // pair-table type ID (atomic number)
+    std::vector<int>   imageX, imageY, imageZ; // periodic box crossings per axis
+
+private:
+    std::vector<Atom> records_;
+    std::vector<int>  ids_;            // index → ID
+    std::vector<int>  indexOf_;        // ID → index (-1 once removed)
+    BondTable         bonds_;
+};
+
+} // namespace physics
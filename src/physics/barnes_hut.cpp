@@ -0,0 +1,260 @@
+#include "barnes_hut.h"
+#include "morton.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+static constexpr int kMortonBits = 10;        // per axis → tree depth ≤ 10
+static constexpr int kParallelLevel = 2;      // subtrees below this are built in parallel
+
+// ═══════════════════════════════════════════════════════════
+//  Tree construction
+// ═══════════════════════════════════════════════════════════
+void BarnesHutSolver::computeMoments(Node& node) const {
+    node.q = node.px = node.py = node.pz = 0.0f;
+    node.qxx = node.qyy = node.qzz = node.qxy = node.qxz = node.qyz = 0.0f;
+    for (int s = node.begin; s < node.end; ++s) {
+        float q = sq_[s];
+        float dx = sx_[s] - node.cx, dy = sy_[s] - node.cy, dz = sz_[s] - node.cz;
+        float d2 = dx * dx + dy * dy + dz * dz;
+        node.q  += q;
+        node.px += q * dx; node.py += q * dy; node.pz += q * dz;
+        node.qxx += q * (3.0f * dx * dx - d2);
+        node.qyy += q * (3.0f * dy * dy - d2);
+        node.qzz += q * (3.0f * dz * dz - d2);
+        node.qxy += q * 3.0f * dx * dy;
+        node.qxz += q * 3.0f * dx * dz;
+        node.qyz += q * 3.0f * dy * dz;
+    }
+}
+
+int BarnesHutSolver::buildNode(std::vector<Node>& arena, int begin, int end,
+                               float cx, float cy, float cz, float half,
+                               int level, int stopLevel, std::vector<int>* deferred) const {
+    int index = static_cast<int>(arena.size());
+    arena.push_back(Node{});
+    {
+        Node& node = arena[index];
+        node.cx = cx; node.cy = cy; node.cz = cz; node.half = half;
+        node.begin = begin; node.end = end;
+        std::fill(std::begin(node.child), std::end(node.child), -1);
+        computeMoments(node);
+    }
+
+    if (end - begin <= settings_.leafSize || level >= kMortonBits) return index;
+    if (level == stopLevel) { deferred->push_back(index); return index; }
+
+    // Children are contiguous runs of the same octant digit
+    int shift = 3 * (kMortonBits - 1 - level);
+    float h = 0.5f * half;
+    int s = begin;
+    while (s < end) {
+        uint32_t octant = (codes_[s] >> shift) & 7u;
+        int e = s;
+        while (e < end && ((codes_[e] >> shift) & 7u) == octant) ++e;
+        int child = buildNode(arena, s, e,
+                              cx + ((octant & 1u) ? h : -h),
+                              cy + ((octant & 2u) ? h : -h),
+                              cz + ((octant & 4u) ? h : -h),
+                              h, level + 1, stopLevel, deferred);
+        arena[index].child[octant] = child;
+        s = e;
+    }
+    return index;
+}
+
+void BarnesHutSolver::build(const AtomStore& atoms, const std::vector<float>& charge,
+                            ThreadPool& pool) {
+    // Charged atoms and their bounding cube
+    order_.clear();
+    float lo[3] = { 1e30f,  1e30f,  1e30f};
+    float hi[3] = {-1e30f, -1e30f, -1e30f};
+    for (int i = 0; i < atoms.size(); ++i) {
+        if (charge[i] == 0.0f) continue;
+        order_.push_back(i);
+        lo[0] = std::min(lo[0], atoms.x[i]); hi[0] = std::max(hi[0], atoms.x[i]);
+        lo[1] = std::min(lo[1], atoms.y[i]); hi[1] = std::max(hi[1], atoms.y[i]);
+        lo[2] = std::min(lo[2], atoms.z[i]); hi[2] = std::max(hi[2], atoms.z[i]);
+    }
+    nodes_.clear();
+    int nq = static_cast<int>(order_.size());
+    if (nq == 0) return;
+
+    float extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2], 1e-3f}) * 1.0001f;
+    float scale = (1 << kMortonBits) / extent;
+
+    // Morton sort
+    codes_.resize(nq);
+    std::vector<uint64_t> keyed(nq);
+    for (int s = 0; s < nq; ++s) {
+        int i = order_[s];
+        auto quantise = [&](float p, float l) {
+            return static_cast<uint32_t>(std::clamp(static_cast<int>((p - l) * scale), 0, (1 << kMortonBits) - 1));
+        };
+        uint32_t code = mortonCode(quantise(atoms.x[i], lo[0]), quantise(atoms.y[i], lo[1]),
+                                   quantise(atoms.z[i], lo[2]));
+        keyed[s] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(i);
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    sx_.resize(nq); sy_.resize(nq); sz_.resize(nq); sq_.resize(nq);
+    for (int s = 0; s < nq; ++s) {
+        int i = static_cast<int>(keyed[s] & 0xffffffffu);
+        codes_[s] = static_cast<uint32_t>(keyed[s] >> 32);
+        order_[s] = i;
+        sx_[s] = atoms.x[i]; sy_[s] = atoms.y[i]; sz_[s] = atoms.z[i];
+        sq_[s] = charge[i];
+    }
+
+    // Top levels serially; cells still open at kParallelLevel are deferred
+    float half = 0.5f * extent;
+    std::vector<int> deferred;
+    buildNode(nodes_, 0, nq, lo[0] + half, lo[1] + half, lo[2] + half, half,
+              0, kParallelLevel, &deferred);
+
+    // Subtrees in parallel, each into its own arena (root at index 0)
+    int subtrees = static_cast<int>(deferred.size());
+    std::vector<std::vector<Node>> arenas(subtrees);
+    pool.run(subtrees, [&](int t, int) {
+        const Node& root = nodes_[deferred[t]];
+        buildNode(arenas[t], root.begin, root.end, root.cx, root.cy, root.cz, root.half,
+                  kParallelLevel, -1, nullptr);
+    });
+
+    // Splice: arena node k ≥ 1 goes to base + k - 1; the arena root replaces
+    // its deferred placeholder
+    for (int t = 0; t < subtrees; ++t) {
+        const auto& arena = arenas[t];
+        int base = static_cast<int>(nodes_.size());
+        auto remap = [&](Node& node) {
+            for (int& c : node.child) if (c > 0) c = base + c - 1;
+        };
+        nodes_[deferred[t]] = arena[0];
+        remap(nodes_[deferred[t]]);
+        for (size_t k = 1; k < arena.size(); ++k) {
+            nodes_.push_back(arena[k]);
+            remap(nodes_.back());
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Field evaluation
+// ═══════════════════════════════════════════════════════════
+void BarnesHutSolver::evaluate(int s, float coulK, float& ex, float& ey, float& ez,
+                               float& phi) const {
+    float x = sx_[s], y = sy_[s], z = sz_[s];
+    float theta2 = settings_.theta * settings_.theta;
+    ex = ey = ez = phi = 0.0f;
+
+    int stack[8 * kMortonBits + 8];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        float rx = x - node.cx, ry = y - node.cy, rz = z - node.cz;
+        float r2 = rx * rx + ry * ry + rz * rz;
+        float size = 2.0f * node.half;
+        bool leaf = std::all_of(std::begin(node.child), std::end(node.child),
+                                [](int c) { return c < 0; });
+
+        if (!leaf && size * size < theta2 * r2) {
+            // Far cell: multipole expansion about its centre
+            float inv2 = 1.0f / r2;
+            float inv  = std::sqrt(inv2);
+            float inv3 = inv * inv2, inv5 = inv3 * inv2, inv7 = inv5 * inv2;
+            float pr = node.px * rx + node.py * ry + node.pz * rz;
+            float qrx = node.qxx * rx + node.qxy * ry + node.qxz * rz;
+            float qry = node.qxy * rx + node.qyy * ry + node.qyz * rz;
+            float qrz = node.qxz * rx + node.qyz * ry + node.qzz * rz;
+            float rqr = rx * qrx + ry * qry + rz * qrz;
+
+            phi += node.q * inv + pr * inv3 + 0.5f * rqr * inv5;
+            float radial = node.q * inv3 + 3.0f * pr * inv5 + 2.5f * rqr * inv7;
+            ex += radial * rx - node.px * inv3 - qrx * inv5;
+            ey += radial * ry - node.py * inv3 - qry * inv5;
+            ez += radial * rz - node.pz * inv3 - qrz * inv5;
+        } else if (leaf) {
+            // Near leaf: direct sum with the pair kernel's soft core
+            for (int t = node.begin; t < node.end; ++t) {
+                float dx = x - sx_[t], dy = y - sy_[t], dz = z - sz_[t];
+                float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+                if (dist < 0.01f) continue;    // self, or coincident
+                float invSoft = 1.0f / std::max(dist, 0.5f);
+                float e = sq_[t] * invSoft * invSoft / dist;
+                phi += sq_[t] * invSoft;
+                ex += e * dx; ey += e * dy; ez += e * dz;
+            }
+        } else {
+            for (int c : node.child)
+                if (c >= 0) stack[top++] = c;
+        }
+    }
+
+    ex *= coulK; ey *= coulK; ez *= coulK; phi *= coulK;
+}
+
+double BarnesHutSolver::compute(AtomStore& atoms, const std::vector<float>& charge,
+                                float coulK, const Settings& settings, ThreadPool& pool) {
+    settings_ = settings;
+    settings_.leafSize = std::max(settings.leafSize, 1);
+    build(atoms, charge, pool);
+
+    int nq = static_cast<int>(order_.size());
+    if (nq == 0) return 0.0;
+    treeFx_.resize(nq); treeFy_.resize(nq); treeFz_.resize(nq);
+
+    // Fixed ranges so the energy sum is independent of scheduling
+    int tasks = std::min(nq, 4 * pool.size());
+    std::vector<double> taskEnergy(tasks, 0.0);
+    pool.run(tasks, [&](int task, int) {
+        int begin = nq * task / tasks, end = nq * (task + 1) / tasks;
+        double energy = 0.0;
+        for (int s = begin; s < end; ++s) {
+            float ex, ey, ez, phi;
+            evaluate(s, coulK, ex, ey, ez, phi);
+            float q = sq_[s];
+            treeFx_[s] = q * ex; treeFy_[s] = q * ey; treeFz_[s] = q * ez;
+            int i = order_[s];
+            atoms.fx[i] += treeFx_[s];
+            atoms.fy[i] += treeFy_[s];
+            atoms.fz[i] += treeFz_[s];
+            energy += 0.5 * q * phi;
+        }
+        taskEnergy[task] = energy;
+    });
+
+    double energy = 0.0;
+    for (double e : taskEnergy) energy += e;
+    return energy;
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Accuracy against direct summation
+// ═══════════════════════════════════════════════════════════
+float BarnesHutSolver::sampleError(float coulK, int samples) const {
+    int nq = static_cast<int>(order_.size());
+    if (nq == 0 || samples <= 0 || static_cast<int>(treeFx_.size()) != nq) return 0.0f;
+    samples = std::min(samples, nq);
+
+    double errSum = 0.0, refSum = 0.0;
+    for (int k = 0; k < samples; ++k) {
+        int s = static_cast<int>(static_cast<long long>(nq) * k / samples);
+        double fx = 0.0, fy = 0.0, fz = 0.0;
+        for (int t = 0; t < nq; ++t) {
+            double dx = sx_[s] - sx_[t], dy = sy_[s] - sy_[t], dz = sz_[s] - sz_[t];
+            double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (dist < 0.01) continue;
+            double invSoft = 1.0 / std::max(dist, 0.5);
+            double e = coulK * sq_[s] * sq_[t] * invSoft * invSoft / dist;
+            fx += e * dx; fy += e * dy; fz += e * dz;
+        }
+        double ex = treeFx_[s] - fx, ey = treeFy_[s] - fy, ez = treeFz_[s] - fz;
+        errSum += ex * ex + ey * ey + ez * ez;
+        refSum += fx * fx + fy * fy + fz * fz;
+    }
+    return refSum > 0.0 ? static_cast<float>(std::sqrt(errSum / refSum)) : 0.0f;
+}
+
+} // namespace physics
@@ -0,0 +1,66 @@
+#pragma once
+#include "atom_store.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+/// Barnes–Hut octree for open-boundary Coulomb without a cutoff.
+///
+/// Charged atoms are sorted along a Morton curve, so every octree cell owns
+/// a contiguous range of them. The top two levels are built serially and
+/// the (up to 64) subtrees below them in parallel. Each cell carries its
+/// monopole, dipole and traceless quadrupole about the cell centre; a cell
+/// is used as a whole when size / distance < θ, otherwise it is opened.
+/// Leaves are summed directly with the same 0.5 Å soft core as the pair
+/// kernel.
+class BarnesHutSolver {
+public:
+    struct Settings {
+        float theta    = 0.5f;     // opening angle (0 = exact, slower)
+        int   leafSize = 8;        // max charges per leaf
+    };
+
+    /// Rebuild the tree and add Coulomb forces to every charged atom.
+    /// Returns the Coulomb energy in eV.
+    double compute(AtomStore& atoms, const std::vector<float>& charge,
+                   float coulK, const Settings& settings, ThreadPool& pool);
+
+    /// RMS relative force error of the last compute() against direct
+    /// summation, over up to `samples` evenly spaced charged atoms (as
+    /// positioned and charged in that compute). O(samples·N).
+    float sampleError(float coulK, int samples) const;
+
+    int nodeCount() const { return static_cast<int>(nodes_.size()); }
+
+private:
+    struct Node {
+        float cx, cy, cz, half;        // cell centre and half-width (Å)
+        int begin, end;                // range in the Morton-sorted charges
+        int child[8];                  // -1 = empty octant; all -1 = leaf
+        float q;                       // monopole (e)
+        float px, py, pz;              // dipole about the centre (e·Å)
+        float qxx, qyy, qzz, qxy, qxz, qyz;   // traceless quadrupole (e·Å²)
+    };
+
+    Settings settings_;
+    std::vector<Node> nodes_;
+
+    // Charged atoms in Morton order, with their positions and charges
+    std::vector<uint32_t> codes_;
+    std::vector<int> order_;
+    std::vector<float> sx_, sy_, sz_, sq_;
+    std::vector<float> treeFx_, treeFy_, treeFz_;   // last result, by sorted slot
+
+    void build(const AtomStore& atoms, const std::vector<float>& charge, ThreadPool& pool);
+    int buildNode(std::vector<Node>& arena, int begin, int end,
+                  float cx, float cy, float cz, float half, int level, int stopLevel,
+                  std::vector<int>* deferred) const;
+    void computeMoments(Node& node) const;
+
+    /// Field (per unit charge) and potential at slot s.
+    void evaluate(int s, float coulK, float& ex, float& ey, float& ez, float& phi) const;
+};
+
+} // namespace physics
@@ -0,0 +1,135 @@
+#include "bond_table.h"
+#include <algorithm>
+#include <numeric>
+
+namespace physics {
+
+static constexpr int kInitialCapacity = 4;    // edges per atom before a segment grows
+
+void BondTable::clear() {
+    bonds_.clear(); edgeAt_.clear(); freeSlots_.clear();
+    edges_.clear();
+    begin_.clear(); degree_.clear(); capacity_.clear();
+    holes_ = 0;
+    ++version_;
+}
+
+void BondTable::addAtom() {
+    begin_.push_back(static_cast<int>(edges_.size()));
+    degree_.push_back(0);
+    capacity_.push_back(kInitialCapacity);
+    edges_.resize(edges_.size() + kInitialCapacity);
+    ++version_;
+}
+
+int BondTable::add(const Bond& bond) {
+    ++version_;
+    int slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        bonds_[slot] = bond;
+    } else {
+        slot = static_cast<int>(bonds_.size());
+        bonds_.push_back(bond);
+        edgeAt_.resize(edgeAt_.size() + 2);
+    }
+
+    const int ends[2] = {bond.atomA, bond.atomB};
+    for (int e = 0; e < 2; ++e) {
+        int i = ends[e];
+        if (degree_[i] == capacity_[i]) grow(i);
+        int pos = begin_[i] + degree_[i]++;
+        edges_[pos] = {ends[1 - e], slot};
+        edgeAt_[2 * slot + e] = pos;
+    }
+
+    if (holes_ > 64 && 2 * holes_ > static_cast<int>(edges_.size())) {
+        std::vector<int> identity(begin_.size());
+        std::iota(identity.begin(), identity.end(), 0);
+        relayout(identity, nullptr);
+    }
+    return slot;
+}
+
+void BondTable::remove(int slot) {
+    ++version_;
+    const int ends[2] = {bonds_[slot].atomA, bonds_[slot].atomB};
+    for (int e = 0; e < 2; ++e) {
+        // Swap-remove: the atom's last edge takes this edge's place
+        int i = ends[e];
+        int pos = edgeAt_[2 * slot + e];
+        int last = begin_[i] + --degree_[i];
+        if (pos != last) {
+            edges_[pos] = edges_[last];
+            edgeSlot(edges_[pos].bond, i) = pos;
+        }
+    }
+    bonds_[slot].atomA = bonds_[slot].atomB = -1;
+    freeSlots_.push_back(slot);
+}
+
+void BondTable::grow(int i) {
+    int from = begin_[i], to = static_cast<int>(edges_.size());
+    int capacity = 2 * std::max(capacity_[i], 1);
+    edges_.resize(edges_.size() + capacity);
+    for (int k = 0; k < degree_[i]; ++k) {
+        edges_[to + k] = edges_[from + k];
+        edgeSlot(edges_[to + k].bond, i) = to + k;
+    }
+    holes_ += capacity_[i];
+    begin_[i] = to;
+    capacity_[i] = capacity;
+}
+
+void BondTable::relayout(const std::vector<int>& oldIndex, const std::vector<int>* newIndex) {
+    int n = static_cast<int>(oldIndex.size());
+    std::vector<Edge> edges;
+    std::vector<int> begin(n), degree(n), capacity(n);
+
+    size_t total = 0;
+    for (int k = 0; k < n; ++k) {
+        capacity[k] = std::max(kInitialCapacity, degree_[oldIndex[k]]);
+        total += capacity[k];
+    }
+    edges.resize(total);
+
+    int pos = 0;
+    for (int k = 0; k < n; ++k) {
+        int old = oldIndex[k];
+        begin[k] = pos;
+        degree[k] = 0;
+        for (int e = begin_[old]; e < begin_[old] + degree_[old]; ++e) {
+            Edge edge = edges_[e];
+            if (bonds_[edge.bond].atomA < 0) continue;          // freed by remap
+            if (newIndex) edge.otherAtomIdx = (*newIndex)[edge.otherAtomIdx];
+            edges[pos + degree[k]] = edge;
+            // The record's endpoints are renamed already, so match on the new index
+            edgeAt_[2 * edge.bond + (bonds_[edge.bond].atomA == k ? 0 : 1)] = pos + degree[k];
+            ++degree[k];
+        }
+        pos += capacity[k];
+    }
+
+    edges_.swap(edges);
+    begin_.swap(begin); degree_.swap(degree); capacity_.swap(capacity);
+    holes_ = 0;
+}
+
+void BondTable::remap(const std::vector<int>& oldIndex, const std::vector<int>& newIndex) {
+    ++version_;
+    for (int slot = 0; slot < slots(); ++slot) {
+        Bond& b = bonds_[slot];
+        if (b.atomA < 0) continue;
+        int a = newIndex[b.atomA], c = newIndex[b.atomB];
+        if (a < 0 || c < 0) {
+            b.atomA = b.atomB = -1;
+            freeSlots_.push_back(slot);
+        } else {
+            b.atomA = a; b.atomB = c;
+        }
+    }
+    relayout(oldIndex, &newIndex);
+}
+
+} // namespace physics
@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+
+namespace physics {
+
+/// A chemical bond between atoms atomA and atomB (store indices).
+struct Bond {
+    int atomA = -1, atomB = -1;  // -1: free slot in the table
+    enum Type { IONIC, COVALENT, METALLIC, HYDROGEN, VDW } type = COVALENT;
+    int order = 1;               // single=1, double=2, triple=3
+    float strength = 1.0f;       // eV (bond dissociation energy)
+    float equilibriumDist = 0;   // Å
+    float morseAlpha = 1.0f;     // Morse potential width parameter
+
+    /// The partner of atom i in this bond.
+    int other(int i) const { return i == atomA ? atomB : atomA; }
+};
+
+/// Central bond storage: one record per bond in a slot array (freed slots
+/// are reused), plus per-atom adjacency in a single edge array — CSR with
+/// slack, so each atom's segment can grow in place up to its capacity.
+///
+/// Adding a bond is amortised O(1): a full segment moves to the end of
+/// the edge array with twice the room, leaving a hole that is compacted
+/// away once holes make up half the array. Removing a bond is O(1): each
+/// record knows where its two edges sit, and they are swap-removed.
+/// Removal reorders the remaining edges of both atoms.
+class BondTable {
+public:
+    /// One end of a bond, in an atom's adjacency segment.
+    struct Edge {
+        int otherAtomIdx;
+        int bond;                // slot in the table
+    };
+
+    /// An atom's edges (valid until the table is next modified).
+    struct Range {
+        const Edge* first;
+        const Edge* last;
+        const Edge* begin() const { return first; }
+        const Edge* end()   const { return last; }
+        int  size()  const { return static_cast<int>(last - first); }
+        bool empty() const { return first == last; }
+        const Edge& operator[](int k) const { return first[k]; }
+    };
+
+    void clear();
+
+    /// Append an atom with no bonds.
+    void addAtom();
+
+    /// Add a bond between bond.atomA and bond.atomB. Returns its slot.
+    int add(const Bond& bond);
+
+    /// Remove the bond in a slot.
+    void remove(int slot);
+
+    /// Bonds of atom i.
+    Range of(int i) const {
+        const Edge* first = edges_.data() + begin_[i];
+        return {first, first + degree_[i]};
+    }
+    int degree(int i) const { return degree_[i]; }
+
+    const Bond& operator[](int slot) const { return bonds_[slot]; }
+    /// Slots are in [0, slots()); free ones have atomA = -1.
+    int slots() const { return static_cast<int>(bonds_.size()); }
+    int count() const { return static_cast<int>(bonds_.size() - freeSlots_.size()); }
+
+    /// Bumped on every change (atoms or bonds), so snapshots of the table
+    /// can tell when they are stale.
+    unsigned version() const { return version_; }
+
+    /// Renumber atoms after AtomStore::reorder: new atom k was old atom
+    /// oldIndex[k]; newIndex maps old → new (-1 = removed). Bonds touching
+    /// removed atoms are freed. Segments are laid out afresh, in order.
+    void remap(const std::vector<int>& oldIndex, const std::vector<int>& newIndex);
+
+private:
+    std::vector<Bond> bonds_;
+    std::vector<int>  edgeAt_;         // per slot: positions of the atomA and atomB edges
+    std::vector<int>  freeSlots_;
+    std::vector<Edge> edges_;
+    std::vector<int>  begin_, degree_, capacity_;   // per atom segment
+    int holes_ = 0;                    // edge slots left behind by grown segments
+    unsigned version_ = 0;
+
+    /// Move atom i's segment to the end of the edge array with twice the room.
+    void grow(int i);
+
+    /// Lay out the segments again with no holes: new atom k takes old
+    /// atom oldIndex[k]'s edges, partners renamed through newIndex.
+    void relayout(const std::vector<int>& oldIndex, const std::vector<int>* newIndex);
+
+    int& edgeSlot(int slot, int atom) {
+        return edgeAt_[2 * slot + (bonds_[slot].atomA == atom ? 0 : 1)];
+    }
+};
+
+} // namespace physics
@@ -0,0 +1,93 @@
+#include "bonded_pairs.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace physics {
+
+static constexpr float kAngleSpring = 2.0f;   // eV/rad² — angle spring constant
+
+// VSEPR ideal bond angle (degrees) from the steric number
+static float idealBondAngle(int stericNumber) {
+    switch (stericNumber) {
+        case 2: return 180.0f;   // linear
+        case 3: return 120.0f;   // trigonal planar
+        case 4: return 109.47f;  // tetrahedral
+        case 5: return 90.0f;    // trigonal bipyramidal (equatorial-axial)
+        case 6: return 90.0f;    // octahedral
+        default: return 109.47f;
+    }
+}
+
+void BondedPairs::rebuild(const AtomStore& atoms) {
+    int n = atoms.size();
+    atomCount_ = n;
+    tableVersion_ = atoms.bonds().version();
+    ++version_;
+
+    // Walk the adjacency so terms come out grouped by their lower atom
+    const BondTable& table = atoms.bonds();
+    terms_.clear();
+    for (int i = 0; i < n; ++i) {
+        for (const auto& e : table.of(i)) {
+            int j = e.otherAtomIdx;
+            if (j <= i) continue;
+            const Bond& b = table[e.bond];
+            terms_.push_back({i, j, b.strength, b.morseAlpha, b.equilibriumDist});
+        }
+    }
+
+    // Load factor ≤ 0.5 keeps linear-probe chains short
+    count_ = static_cast<int>(terms_.size());
+    size_t capacity = 16;
+    int bits = 4;
+    while (capacity < 2 * terms_.size()) { capacity <<= 1; ++bits; }
+    keys_.assign(capacity, kEmpty);
+    mask_ = capacity - 1;
+    shift_ = 64 - bits;
+
+    for (const auto& t : terms_) {
+        uint64_t key = pairKey(t.i, t.j);
+        size_t s = slotOf(key);
+        while (keys_[s] != kEmpty && keys_[s] != key) s = (s + 1) & mask_;
+        keys_[s] = key;
+    }
+
+    // Angle triplets for every pair of bonds on a centre
+    angles_.centre.clear(); angles_.a.clear(); angles_.b.clear();
+    angles_.cos0.clear(); angles_.k.clear();
+    for (int i = 0; i < n; ++i) {
+        const auto& centre = atoms[i];
+        auto edges = table.of(i);
+        int nBonds = edges.size();
+        if (nBonds < 2) continue;
+
+        // Steric number = bonds + lone pairs
+        int lonePairs = std::max(0, (centre.element->valenceElectrons
+                                     - centre.totalBondOrder()) / 2);
+        float theta0 = idealBondAngle(nBonds + lonePairs) * static_cast<float>(M_PI) / 180.0f;
+        float cos0 = std::cos(theta0);
+        float sin0 = std::sin(theta0);
+        bool linear = sin0 < 1e-3f;
+        if (linear) cos0 = -1.0f;
+        // Match the curvature of ½k(θ − θ₀)² at θ₀
+        float k = linear ? kAngleSpring : kAngleSpring / (sin0 * sin0);
+
+        for (int bi = 0; bi < nBonds; ++bi) {
+            int a = edges[bi].otherAtomIdx;
+            for (int bj = bi + 1; bj < nBonds; ++bj) {
+                int b = edges[bj].otherAtomIdx;
+                angles_.centre.push_back(i);
+                angles_.a.push_back(a);
+                angles_.b.push_back(b);
+                angles_.cos0.push_back(cos0);
+                angles_.k.push_back(k);
+            }
+        }
+    }
+}
+
+} // namespace physics
@@ -0,0 +1,76 @@
+#pragma once
+#include "atom_store.h"
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+/// Flat snapshot of the bond topology: an open-addressed hash set of bonded
+/// pairs for O(1) exclusion tests in the pair loop, a compact list of
+/// Morse terms so bonded forces are a single pass over bonds, and the VSEPR
+/// angle triplets with their ideal angles already resolved.
+/// Rebuilt whenever the bond table changes (see current()).
+class BondedPairs {
+public:
+    struct Term {
+        int i, j;                      // i < j
+        float De, alpha, re;           // Morse parameters (eV, 1/Å, Å)
+    };
+
+    /// Bond angles a–centre–b, one entry per pair of bonds on a centre
+    /// (struct of arrays, for the SIMD angle kernel).
+    struct Angles {
+        std::vector<int> centre, a, b;
+        std::vector<float> cos0;       // cos θ₀ from the VSEPR steric number
+        std::vector<float> k;          // eV — see angleForces()
+        int size() const { return static_cast<int>(centre.size()); }
+    };
+
+    /// Snapshot every bond in the store's bond table.
+    void rebuild(const AtomStore& atoms);
+
+    /// Is (i, j) bonded? Order of i and j does not matter.
+    bool contains(int i, int j) const {
+        if (count_ == 0) return false;
+        uint64_t key = pairKey(i, j);
+        for (size_t s = slotOf(key); ; s = (s + 1) & mask_) {
+            if (keys_[s] == key) return true;
+            if (keys_[s] == kEmpty) return false;
+        }
+    }
+
+    const std::vector<Term>& terms() const { return terms_; }
+    const Angles& angles() const { return angles_; }
+    int atomCount() const { return atomCount_; }
+
+    /// Was this snapshot taken from the store's bond table as it is now?
+    bool current(const AtomStore& atoms) const {
+        return atomCount_ == atoms.size() && tableVersion_ == atoms.bonds().version();
+    }
+
+    /// Bumped on every rebuild, so callers can cache per-pair exclusion flags.
+    unsigned version() const { return version_; }
+
+private:
+    static constexpr uint64_t kEmpty = ~uint64_t(0);
+
+    std::vector<uint64_t> keys_;       // capacity is a power of two
+    size_t mask_ = 0;
+    int shift_ = 64;
+    int count_ = 0;
+    std::vector<Term> terms_;
+    Angles angles_;
+    int atomCount_ = 0;
+    unsigned version_ = 0;
+    unsigned tableVersion_ = ~0u;      // BondTable version snapshotted
+
+    static uint64_t pairKey(int i, int j) {
+        if (i > j) { int t = i; i = j; j = t; }
+        return (static_cast<uint64_t>(static_cast<uint32_t>(i)) << 32) | static_cast<uint32_t>(j);
+    }
+    size_t slotOf(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);   // Fibonacci hashing
+    }
+};
+
+} // namespace physics
@@ -0,0 +1,39 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cmath>
+
+namespace physics {
+
+/// Cubic simulation box [-halfWidth, halfWidth)³, optionally periodic.
+/// With periodic set, every separation goes through the minimum-image
+/// convention, which is valid for interaction ranges up to halfWidth.
+struct Box {
+    float halfWidth = 50.0f;   // Å
+    bool  periodic  = false;
+
+    float length() const { return 2.0f * halfWidth; }
+
+    /// Nearest-image version of a separation component.
+    float minimumImage(float d) const {
+        if (!periodic) return d;
+        float L = length();
+        return d - L * std::floor(d / L + 0.5f);
+    }
+
+    /// a - b, reduced to the nearest image when periodic.
+    glm::vec3 delta(glm::vec3 a, glm::vec3 b) const {
+        glm::vec3 d = a - b;
+        return glm::vec3(minimumImage(d.x), minimumImage(d.y), minimumImage(d.z));
+    }
+
+    /// Wrap a coordinate into [-halfWidth, halfWidth). Returns the number of
+    /// box lengths added (the change in the atom's image flag).
+    int wrap(float& x) const {
+        float L = length();
+        int shift = static_cast<int>(std::floor((x + halfWidth) / L));
+        if (shift != 0) x -= shift * L;
+        return shift;
+    }
+};
+
+} // namespace physics
@@ -0,0 +1,49 @@
+#include "cell_grid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+void CellGrid::build(const AtomStore& atoms, const Box& box, float minCellSize) {
+    int n = atoms.size();
+    float halfWidth = box.halfWidth;
+    periodic_ = box.periodic;
+
+    // Cells per axis: as many as fit at minCellSize, but no more than ~8 per
+    // atom overall so sparse boxes don't allocate huge empty grids.
+    float width = 2.0f * halfWidth;
+    int dim = static_cast<int>(width / std::max(minCellSize, 1e-3f));
+    int maxDim = std::max(1, 2 * static_cast<int>(std::cbrt(static_cast<float>(n))));
+    dim_ = std::clamp(dim, 1, maxDim);
+
+    // A wrapped half-shell stencil needs 3+ cells per axis to visit each
+    // cell pair once; below that a single, unwrapped cell holds every pair.
+    if (periodic_ && dim_ < 3) { dim_ = 1; periodic_ = false; }
+
+    float invCell = dim_ / std::max(width, 1e-3f);
+    int cellCount = dim_ * dim_ * dim_;
+
+    // Counting sort of atoms into cells
+    cellStart_.assign(cellCount + 1, 0);
+    atomCell_.resize(n);
+    auto toCell = [&](float p) {
+        int c = static_cast<int>(std::floor((p + halfWidth) * invCell));
+        return periodic_ ? ((c % dim_) + dim_) % dim_ : std::clamp(c, 0, dim_ - 1);
+    };
+    for (int i = 0; i < n; ++i) {
+        int cx = toCell(atoms.x[i]);
+        int cy = toCell(atoms.y[i]);
+        int cz = toCell(atoms.z[i]);
+        atomCell_[i] = cellIndex(cx, cy, cz);
+        cellStart_[atomCell_[i] + 1]++;
+    }
+    for (int c = 0; c < cellCount; ++c)
+        cellStart_[c + 1] += cellStart_[c];
+
+    cellAtoms_.resize(n);
+    cursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (int i = 0; i < n; ++i)
+        cellAtoms_[cursor_[atomCell_[i]]++] = i;
+}
+
+} // namespace physics
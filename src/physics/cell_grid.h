@@ -0,0 +1,103 @@
+#pragma once
+#include "atom_store.h"
+#include "box.h"
+#include <vector>
+
+namespace physics {
+
+/// Uniform cubic cell grid over the simulation box.
+/// Every cell is at least `minCellSize` wide, so any pair closer than that
+/// lies in the same or an adjacent cell. Atoms outside the box are clamped
+/// into the boundary cells, which keeps that guarantee. In a periodic box
+/// cells wrap instead, and the stencil reaches across the box faces.
+class CellGrid {
+public:
+    /// Bin atoms into cells covering the box.
+    void build(const AtomStore& atoms, const Box& box, float minCellSize);
+
+    /// Visit every candidate pair (i, j) exactly once, using a half-shell
+    /// stencil (own cell + 13 forward neighbours).
+    template <typename Fn>
+    void forEachPair(Fn&& fn) const;
+
+    /// Visit every candidate partner j of atom i once: atoms in its own
+    /// cell and the 26 surrounding ones. Needs the grid built over the
+    /// same atoms.
+    template <typename Fn>
+    void forEachNeighbor(int i, Fn&& fn) const;
+
+    int cellsPerAxis() const { return dim_; }
+
+private:
+    int dim_ = 1;
+    bool periodic_ = false;
+    std::vector<int> cellStart_;   // CSR offsets, size cellCount + 1
+    std::vector<int> cellAtoms_;   // atom indices sorted by cell
+    std::vector<int> atomCell_;    // scratch: cell of each atom
+    std::vector<int> cursor_;      // scratch: fill position per cell
+
+    int cellIndex(int cx, int cy, int cz) const { return (cz * dim_ + cy) * dim_ + cx; }
+};
+
+template <typename Fn>
+void CellGrid::forEachPair(Fn&& fn) const {
+    // Half of the 26 neighbours: each unordered cell pair is visited once.
+    static const int stencil[13][3] = {
+        { 1, 0, 0}, {-1, 1, 0}, { 0, 1, 0}, { 1, 1, 0},
+        {-1,-1, 1}, { 0,-1, 1}, { 1,-1, 1},
+        {-1, 0, 1}, { 0, 0, 1}, { 1, 0, 1},
+        {-1, 1, 1}, { 0, 1, 1}, { 1, 1, 1}
+    };
+
+    for (int cz = 0; cz < dim_; ++cz)
+    for (int cy = 0; cy < dim_; ++cy)
+    for (int cx = 0; cx < dim_; ++cx) {
+        int c = cellIndex(cx, cy, cz);
+        int begin = cellStart_[c], end = cellStart_[c + 1];
+        if (begin == end) continue;
+
+        // Pairs within the cell
+        for (int a = begin; a < end; ++a)
+            for (int b = a + 1; b < end; ++b)
+                fn(cellAtoms_[a], cellAtoms_[b]);
+
+        // Pairs with forward neighbour cells
+        for (const auto& s : stencil) {
+            int nx = cx + s[0], ny = cy + s[1], nz = cz + s[2];
+            if (periodic_) {
+                nx = (nx + dim_) % dim_; ny = (ny + dim_) % dim_; nz = (nz + dim_) % dim_;
+            } else if (nx < 0 || ny < 0 || nz < 0 || nx >= dim_ || ny >= dim_ || nz >= dim_) {
+                continue;
+            }
+            int n = cellIndex(nx, ny, nz);
+            int nBegin = cellStart_[n], nEnd = cellStart_[n + 1];
+            for (int a = begin; a < end; ++a)
+                for (int b = nBegin; b < nEnd; ++b)
+                    fn(cellAtoms_[a], cellAtoms_[b]);
+        }
+    }
+}
+
+template <typename Fn>
+void CellGrid::forEachNeighbor(int i, Fn&& fn) const {
+    int c = atomCell_[i];
+    int cx = c % dim_, cy = (c / dim_) % dim_, cz = c / (dim_ * dim_);
+    // A periodic grid has 3+ cells per axis or just one (see build), so
+    // wrapped offsets never name a cell twice
+    int lo = (dim_ == 1) ? 0 : -1, hi = (dim_ == 1) ? 0 : 1;
+    for (int dz = lo; dz <= hi; ++dz)
+    for (int dy = lo; dy <= hi; ++dy)
+    for (int dx = lo; dx <= hi; ++dx) {
+        int nx = cx + dx, ny = cy + dy, nz = cz + dz;
+        if (periodic_) {
+            nx = (nx + dim_) % dim_; ny = (ny + dim_) % dim_; nz = (nz + dim_) % dim_;
+        } else if (nx < 0 || ny < 0 || nz < 0 || nx >= dim_ || ny >= dim_ || nz >= dim_) {
+            continue;
+        }
+        int n = cellIndex(nx, ny, nz);
+        for (int k = cellStart_[n]; k < cellStart_[n + 1]; ++k)
+            if (cellAtoms_[k] != i) fn(cellAtoms_[k]);
+    }
+}
+
+} // namespace physics
@@ -0,0 +1,185 @@
+#include "constraints.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+static constexpr int kChunk = 512;     // constraints per parallel task
+
+// ═══════════════════════════════════════════════════════════
+//  Constraint list and colouring
+// ═══════════════════════════════════════════════════════════
+void ConstraintSolver::update(const AtomStore& atoms, const BondedPairs& bonds,
+                              const Settings& settings, const Box& box) {
+    bool same = settings.mode == settings_.mode &&
+                settings.captureFraction == settings_.captureFraction;
+    settings_ = settings;
+    if (same && !pending_ && bonds.version() == bondVersion_ && atoms.size() == atomCount_)
+        return;
+    bondVersion_ = bonds.version();
+    atomCount_ = atoms.size();
+    pending_ = false;
+
+    ci_.clear(); cj_.clear(); length2_.clear();
+    colourStart_.assign(1, 0);
+    if (settings.mode == Mode::None) return;
+    if (bonds.atomCount() != atoms.size()) { pending_ = true; return; }   // terms are stale
+
+    // Candidate bonds, with greedy edge colouring: each constraint takes
+    // the lowest colour not yet used at either atom
+    struct Candidate { int i, j, colour; float length2; };
+    std::vector<Candidate> candidates;
+    std::vector<unsigned> usedColours(atoms.size(), 0u);   // bit c = colour c taken
+    int colours = 0;
+    for (const auto& t : bonds.terms()) {
+        if (settings.mode == Mode::HydrogenBonds &&
+            atoms[t.i].elementZ != 1 && atoms[t.j].elementZ != 1) continue;
+        if (atoms.invMass[t.i] == 0.0f && atoms.invMass[t.j] == 0.0f) continue;
+        if (t.re <= 0.0f) continue;
+
+        float r = glm::length(box.delta(atoms.pos(t.i), atoms.pos(t.j)));
+        if (std::abs(r - t.re) > settings.captureFraction * t.re) { pending_ = true; continue; }
+
+        unsigned used = usedColours[t.i] | usedColours[t.j];
+        if (used == ~0u) continue;                  // > 32 constraints on one atom
+        int c = 0;
+        while (used & (1u << c)) ++c;
+        usedColours[t.i] |= 1u << c;
+        usedColours[t.j] |= 1u << c;
+        colours = std::max(colours, c + 1);
+        candidates.push_back({t.i, t.j, c, t.re * t.re});
+    }
+
+    // Counting sort by colour
+    colourStart_.assign(colours + 1, 0);
+    for (const auto& c : candidates) colourStart_[c.colour + 1]++;
+    for (int c = 0; c < colours; ++c) colourStart_[c + 1] += colourStart_[c];
+    int m = static_cast<int>(candidates.size());
+    ci_.resize(m); cj_.resize(m); length2_.resize(m);
+    std::vector<int> cursor(colourStart_.begin(), colourStart_.end() - 1);
+    for (const auto& c : candidates) {
+        int k = cursor[c.colour]++;
+        ci_[k] = c.i; cj_[k] = c.j; length2_[k] = c.length2;
+    }
+}
+
+template <typename Fn>
+bool ConstraintSolver::sweepColours(ThreadPool& pool, Fn&& fn) {
+    bool any = false;
+    for (int c = 0; c + 1 < static_cast<int>(colourStart_.size()); ++c) {
+        int begin = colourStart_[c], end = colourStart_[c + 1];
+        int tasks = (end - begin + kChunk - 1) / kChunk;
+        if (tasks <= 1 || pool.size() == 1) {
+            any |= fn(begin, end);
+            continue;
+        }
+        unconverged_.assign(tasks, 0);
+        pool.run(tasks, [&](int t, int) {
+            int b = begin + t * kChunk;
+            unconverged_[t] = fn(b, std::min(b + kChunk, end)) ? 1 : 0;
+        });
+        for (char u : unconverged_) any |= (u != 0);
+    }
+    return any;
+}
+
+// ═══════════════════════════════════════════════════════════
+//  SHAKE (positions) and RATTLE (velocities)
+// ═══════════════════════════════════════════════════════════
+void ConstraintSolver::beginStep(const AtomStore& atoms, const Box& box) {
+    int m = count();
+    refX_.resize(m); refY_.resize(m); refZ_.resize(m);
+    for (int k = 0; k < m; ++k) {
+        glm::vec3 r = box.delta(atoms.pos(ci_[k]), atoms.pos(cj_[k]));
+        refX_[k] = r.x; refY_[k] = r.y; refZ_[k] = r.z;
+    }
+}
+
+int ConstraintSolver::shake(AtomStore& atoms, float dt, const Box& box, ThreadPool& pool) {
+    int m = count();
+    if (m == 0) return 0;
+    shift_.assign(m, 0.0f);
+    const float tol2 = 2.0f * settings_.tolerance;   // on r², ≈ 2× relative length error
+
+    // Move each pair along its pre-drift bond vector until |r| = rₑ:
+    // g = (rₑ² − r²) / (2 (wᵢ + wⱼ) r·r_ref)
+    int iterations = 0;
+    bool unconverged = true;
+    while (unconverged && iterations < settings_.maxIterations) {
+        ++iterations;
+        unconverged = sweepColours(pool, [&](int begin, int end) {
+            bool any = false;
+            for (int k = begin; k < end; ++k) {
+                int i = ci_[k], j = cj_[k];
+                float dx = box.minimumImage(atoms.x[i] - atoms.x[j]);
+                float dy = box.minimumImage(atoms.y[i] - atoms.y[j]);
+                float dz = box.minimumImage(atoms.z[i] - atoms.z[j]);
+                float diff = length2_[k] - (dx * dx + dy * dy + dz * dz);
+                if (std::abs(diff) <= tol2 * length2_[k]) continue;
+
+                float wi = atoms.invMass[i], wj = atoms.invMass[j];
+                float dot = dx * refX_[k] + dy * refY_[k] + dz * refZ_[k];
+                if (dot < 0.1f * length2_[k]) continue;   // rotated ~85°+ in one step: no solution
+                float g = diff / (2.0f * (wi + wj) * dot);
+                shift_[k] += g;
+                atoms.x[i] += g * wi * refX_[k]; atoms.y[i] += g * wi * refY_[k]; atoms.z[i] += g * wi * refZ_[k];
+                atoms.x[j] -= g * wj * refX_[k]; atoms.y[j] -= g * wj * refY_[k]; atoms.z[j] -= g * wj * refZ_[k];
+                any = true;
+            }
+            return any;
+        });
+    }
+
+    // The same displacement, spread over the step, corrects the velocities
+    float invDt = 1.0f / dt;
+    sweepColours(pool, [&](int begin, int end) {
+        for (int k = begin; k < end; ++k) {
+            int i = ci_[k], j = cj_[k];
+            float si = shift_[k] * atoms.invMass[i] * invDt;
+            float sj = shift_[k] * atoms.invMass[j] * invDt;
+            atoms.vx[i] += si * refX_[k]; atoms.vy[i] += si * refY_[k]; atoms.vz[i] += si * refZ_[k];
+            atoms.vx[j] -= sj * refX_[k]; atoms.vy[j] -= sj * refY_[k]; atoms.vz[j] -= sj * refZ_[k];
+        }
+        return false;
+    });
+    return iterations;
+}
+
+int ConstraintSolver::rattle(AtomStore& atoms, float dt, const Box& box, ThreadPool& pool) {
+    int m = count();
+    if (m == 0) return 0;
+
+    // Remove the relative velocity along each bond:
+    // k = r·vᵢⱼ / (rₑ² (wᵢ + wⱼ)); converged when the radial speed would
+    // change the length by less than the tolerance over one step
+    float tolSpeed = settings_.tolerance / dt;
+    int iterations = 0;
+    bool unconverged = true;
+    while (unconverged && iterations < settings_.maxIterations) {
+        ++iterations;
+        unconverged = sweepColours(pool, [&](int begin, int end) {
+            bool any = false;
+            for (int k = begin; k < end; ++k) {
+                int i = ci_[k], j = cj_[k];
+                float dx = box.minimumImage(atoms.x[i] - atoms.x[j]);
+                float dy = box.minimumImage(atoms.y[i] - atoms.y[j]);
+                float dz = box.minimumImage(atoms.z[i] - atoms.z[j]);
+                float vx = atoms.vx[i] - atoms.vx[j];
+                float vy = atoms.vy[i] - atoms.vy[j];
+                float vz = atoms.vz[i] - atoms.vz[j];
+                float rv = dx * vx + dy * vy + dz * vz;
+                if (std::abs(rv) <= tolSpeed * length2_[k]) continue;
+
+                float wi = atoms.invMass[i], wj = atoms.invMass[j];
+                float g = rv / (length2_[k] * (wi + wj));
+                atoms.vx[i] -= g * wi * dx; atoms.vy[i] -= g * wi * dy; atoms.vz[i] -= g * wi * dz;
+                atoms.vx[j] += g * wj * dx; atoms.vy[j] += g * wj * dy; atoms.vz[j] += g * wj * dz;
+                any = true;
+            }
+            return any;
+        });
+    }
+    return iterations;
+}
+
+} // namespace physics
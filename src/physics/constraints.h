@@ -0,0 +1,72 @@
+#pragma once
+#include "atom_store.h"
+#include "bonded_pairs.h"
+#include "box.h"
+#include "thread_pool.h"
+#include <vector>
+
+namespace physics {
+
+/// SHAKE/RATTLE holonomic bond-length constraints.
+///
+/// Constraints are taken from the bond terms (length = Morse rₑ) and
+/// edge-coloured so no two constraints of one colour share an atom. Each
+/// SHAKE/RATTLE iteration sweeps the colours in order, solving all
+/// constraints of a colour in parallel — Gauss–Seidel between colours,
+/// race-free within one.
+///
+/// A freshly formed bond is only constrained once its length is within
+/// captureFraction of rₑ; until then it stays a plain Morse bond.
+class ConstraintSolver {
+public:
+    enum class Mode { None, HydrogenBonds, AllBonds };
+
+    struct Settings {
+        Mode  mode            = Mode::None;
+        float tolerance       = 1e-4f;  // relative bond-length error
+        int   maxIterations   = 200;
+        float captureFraction = 0.1f;   // |r − rₑ| / rₑ to start constraining
+    };
+
+    /// Rebuild the constraint list if the bond topology or settings
+    /// changed, or bonds are still waiting to be captured.
+    void update(const AtomStore& atoms, const BondedPairs& bonds,
+                const Settings& settings, const Box& box);
+
+    /// Record each constrained bond vector before the drift (SHAKE's
+    /// reference direction).
+    void beginStep(const AtomStore& atoms, const Box& box);
+
+    /// Restore bond lengths after the drift, correcting velocities by the
+    /// same displacement / dt. Returns the iterations used.
+    int shake(AtomStore& atoms, float dt, const Box& box, ThreadPool& pool);
+
+    /// Remove velocity components along constrained bonds.
+    /// Returns the iterations used.
+    int rattle(AtomStore& atoms, float dt, const Box& box, ThreadPool& pool);
+
+    int count() const { return static_cast<int>(ci_.size()); }
+    int colourCount() const { return static_cast<int>(colourStart_.size()) - 1; }
+    bool active() const { return !ci_.empty(); }
+
+private:
+    Settings settings_;
+    unsigned bondVersion_ = ~0u;
+    int atomCount_ = -1;
+    bool pending_ = false;             // uncaptured bonds remain
+
+    // Constraints sorted by colour; colour c is [colourStart_[c], colourStart_[c+1])
+    std::vector<int> ci_, cj_;
+    std::vector<float> length2_;       // rₑ² (Å²)
+    std::vector<int> colourStart_;
+    std::vector<float> refX_, refY_, refZ_;   // bond vectors before the drift
+    std::vector<float> shift_;                // accumulated SHAKE multiplier
+    std::vector<char> unconverged_;           // per task, last sweep
+
+    /// Run fn(begin, end) over each colour's constraints in parallel chunks,
+    /// colours in order. Returns true if any task reported unconverged.
+    template <typename Fn>
+    bool sweepColours(ThreadPool& pool, Fn&& fn);
+};
+
+} // namespace physics
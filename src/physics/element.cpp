@@ -1,5 +1,7 @@
 #include "element.h"
+#include "pair_table.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -7,6 +9,51 @@ namespace physics {
 
 ElementData PeriodicTable::dummy_;
 
+static const struct { const char* name; ElementCategory category; } kCategoryNames[] = {
+    {"unknown",               ElementCategory::Unknown},
+    {"nonmetal",              ElementCategory::Nonmetal},
+    {"noble_gas",             ElementCategory::NobleGas},
+    {"alkali_metal",          ElementCategory::AlkaliMetal},
+    {"alkaline_earth",        ElementCategory::AlkalineEarth},
+    {"transition_metal",      ElementCategory::TransitionMetal},
+    {"post_transition_metal", ElementCategory::PostTransitionMetal},
+    {"metalloid",             ElementCategory::Metalloid},
+    {"halogen",               ElementCategory::Halogen},
+    {"lanthanide",            ElementCategory::Lanthanide},
+    {"actinide",              ElementCategory::Actinide},
+};
+
+ElementCategory parseCategory(const std::string& name) {
+    for (const auto& c : kCategoryNames)
+        if (name == c.name) return c.category;
+    return ElementCategory::Unknown;
+}
+
+const char* categoryName(ElementCategory category) {
+    for (const auto& c : kCategoryNames)
+        if (c.category == category) return c.name;
+    return "unknown";
+}
+
+Phase parsePhase(const std::string& name) {
+    if (name == "gas")    return Phase::Gas;
+    if (name == "liquid") return Phase::Liquid;
+    return Phase::Solid;
+}
+
+// The element-only parts of Atom::wantsElectron / wantsToLoseElectron and
+// the bonding loop's noble-gas and missing-χ skips
+static uint8_t computeTraits(const ElementData& e) {
+    uint8_t t = 0;
+    if (e.category != ElementCategory::NobleGas && e.electronegativity >= 0.01f)
+        t |= CanBond;
+    if (e.electronAffinity > 0.3f && e.valenceElectrons < 8)
+        t |= WantsElectron;
+    if (e.ionizationEnergy < 8.0f && e.valenceElectrons <= 2)
+        t |= LosesElectron;
+    return t;
+}
+
 PeriodicTable& PeriodicTable::instance() {
     static PeriodicTable pt;
     return pt;
@@ -51,8 +98,8 @@ bool PeriodicTable::loadFromFile(const std::string& path) {
         e.valenceElectrons = safeInt(val, "valence_electrons", 0);
         e.period           = safeInt(val, "period", 0);
         e.group            = safeInt(val, "group", 0);
-        e.category         = safeStr(val, "category", "unknown");
-        e.phase            = safeStr(val, "phase", "solid");
+        e.category         = parseCategory(safeStr(val, "category", "unknown"));
+        e.phase            = parsePhase(safeStr(val, "phase", "solid"));
         e.meltingPoint     = safeFloat(val, "melting_point_K", 0.0f);
         e.boilingPoint     = safeFloat(val, "boiling_point_K", 0.0f);
         e.density          = safeFloat(val, "density_g_cm3", 0.0f);
@@ -67,9 +114,17 @@ bool PeriodicTable::loadFromFile(const std::string& path) {
                                 c[1].get<float>()/255.f,
                                 c[2].get<float>()/255.f);
         }
+        e.traits = computeTraits(e);
         elements_[e.atomicNumber] = e;
     }
+
+    int maxZ = 0;
+    for (const auto& [z, e] : elements_) maxZ = std::max(maxZ, z);
+    traits_.assign(maxZ + 1, 0);
+    for (const auto& [z, e] : elements_) traits_[z] = e.traits;
     std::cout << "Loaded " << elements_.size() << " elements\n";
+
+    PairTable::instance().build(*this);
     return true;
 }
 
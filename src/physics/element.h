@@ -1,11 +1,31 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 namespace physics {
 
+enum class ElementCategory : uint8_t {
+    Unknown, Nonmetal, NobleGas, AlkaliMetal, AlkalineEarth, TransitionMetal,
+    PostTransitionMetal, Metalloid, Halogen, Lanthanide, Actinide
+};
+
+enum class Phase : uint8_t { Solid, Liquid, Gas };   // at STP
+
+/// Per-element bonding traits, precomputed at load as bit flags.
+enum ElementTraits : uint8_t {
+    CanBond       = 1 << 0,   // not a noble gas, and has an electronegativity
+    WantsElectron = 1 << 1,   // EA > 0.3 eV with an incomplete octet
+    LosesElectron = 1 << 2,   // IE < 8 eV with at most two valence electrons
+};
+
+/// Parse the data file's category / phase strings ("noble_gas", "gas", ...).
+ElementCategory parseCategory(const std::string& name);
+Phase parsePhase(const std::string& name);
+const char* categoryName(ElementCategory c);
+
 struct ElementData {
     int         atomicNumber = 0;
     std::string symbol;
@@ -21,8 +41,9 @@ struct ElementData {
     float       metallicRadius   = 0;   // pm
     int         valenceElectrons = 0;
     int         period = 0, group = 0;
-    std::string category;
-    std::string phase;                  // "solid","liquid","gas" at STP
+    ElementCategory category = ElementCategory::Unknown;
+    Phase       phase  = Phase::Solid;
+    uint8_t     traits = 0;             // ElementTraits flags
     float       meltingPoint     = 0;   // K
     float       boilingPoint     = 0;   // K
     float       density          = 0;   // g/cm³
@@ -39,9 +60,16 @@ public:
     bool has(int atomicNumber) const;
     int count() const { return static_cast<int>(elements_.size()); }
     const std::unordered_map<int, ElementData>& all() const { return elements_; }
+
+    /// ElementTraits flags indexed by atomic number (0 past the last element),
+    /// for loops that only have AtomStore::type.
+    uint8_t traits(int atomicNumber) const {
+        return atomicNumber < static_cast<int>(traits_.size()) ? traits_[atomicNumber] : 0;
+    }
 private:
     PeriodicTable() = default;
     std::unordered_map<int, ElementData> elements_;
+    std::vector<uint8_t> traits_;
     static ElementData dummy_;
 };
 
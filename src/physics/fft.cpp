@@ -0,0 +1,145 @@
+#include "fft.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef PHYSICS_HAVE_FFTW
+#include <fftw3.h>
+#endif
+
+namespace physics {
+
+#ifdef PHYSICS_HAVE_FFTW
+// ═══════════════════════════════════════════════════════════
+//  FFTW backend
+// ═══════════════════════════════════════════════════════════
+Fft3d::~Fft3d() { destroyPlans(); }
+
+void Fft3d::destroyPlans() {
+    if (planForward_) fftwf_destroy_plan(static_cast<fftwf_plan>(planForward_));
+    if (planInverse_) fftwf_destroy_plan(static_cast<fftwf_plan>(planInverse_));
+    planForward_ = planInverse_ = nullptr;
+}
+
+int Fft3d::goodSize(int n) {
+    for (int m = std::max(n, 1); ; ++m) {
+        int r = m;
+        for (int f : {2, 3, 5, 7}) while (r % f == 0) r /= f;
+        if (r == 1) return m;
+    }
+}
+
+void Fft3d::resize(int nx, int ny, int nz) {
+    if (nx == n_[0] && ny == n_[1] && nz == n_[2]) return;
+    destroyPlans();
+    n_[0] = nx; n_[1] = ny; n_[2] = nz;
+    data_.assign(static_cast<size_t>(nx) * ny * nz, Complex(0.0f, 0.0f));
+
+    auto* buf = reinterpret_cast<fftwf_complex*>(data_.data());
+    planForward_ = fftwf_plan_dft_3d(nx, ny, nz, buf, buf, FFTW_FORWARD, FFTW_ESTIMATE);
+    planInverse_ = fftwf_plan_dft_3d(nx, ny, nz, buf, buf, FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+void Fft3d::transform(ThreadPool&, bool inverse) {
+    fftwf_execute(static_cast<fftwf_plan>(inverse ? planInverse_ : planForward_));
+}
+
+#else
+// ═══════════════════════════════════════════════════════════
+//  Bundled radix-2 backend
+// ═══════════════════════════════════════════════════════════
+Fft3d::~Fft3d() = default;
+
+int Fft3d::goodSize(int n) {
+    int m = 1;
+    while (m < n) m <<= 1;
+    return m;
+}
+
+void Fft3d::resize(int nx, int ny, int nz) {
+    if (nx == n_[0] && ny == n_[1] && nz == n_[2]) return;
+    n_[0] = nx; n_[1] = ny; n_[2] = nz;
+    data_.assign(static_cast<size_t>(nx) * ny * nz, Complex(0.0f, 0.0f));
+
+    for (int a = 0; a < 3; ++a) {
+        int n = n_[a];
+        Axis& axis = axes_[a];
+        axis.twiddle.resize(n / 2);
+        for (int k = 0; k < n / 2; ++k) {
+            double angle = -2.0 * M_PI * k / n;
+            axis.twiddle[k] = Complex(static_cast<float>(std::cos(angle)),
+                                      static_cast<float>(std::sin(angle)));
+        }
+        int bits = 0;
+        while ((1 << bits) < n) ++bits;
+        axis.bitReverse.resize(n);
+        for (int k = 0; k < n; ++k) {
+            int r = 0;
+            for (int b = 0; b < bits; ++b)
+                if (k & (1 << b)) r |= 1 << (bits - 1 - b);
+            axis.bitReverse[k] = r;
+        }
+    }
+}
+
+// Iterative Cooley–Tukey. Complex products are written out by hand:
+// std::complex<float>::operator* carries NaN/inf recovery we don't need.
+void Fft3d::transformLines(Complex* a, int n, size_t stride, int width,
+                           const Axis& axis, bool inverse) {
+    for (int k = 0; k < n; ++k) {
+        int r = axis.bitReverse[k];
+        if (k < r) std::swap_ranges(a + k * stride, a + k * stride + width, a + r * stride);
+    }
+    float sign = inverse ? -1.0f : 1.0f;
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len / 2, step = n / len;
+        for (int i = 0; i < n; i += len) {
+            for (int k = 0; k < half; ++k) {
+                const Complex& tw = axis.twiddle[k * step];
+                float wr = tw.real(), wi = sign * tw.imag();
+                float* u = reinterpret_cast<float*>(a + (i + k) * stride);
+                float* v = reinterpret_cast<float*>(a + (i + k + half) * stride);
+                for (int w = 0; w < 2 * width; w += 2) {
+                    float vr = v[w] * wr - v[w + 1] * wi;
+                    float vi = v[w] * wi + v[w + 1] * wr;
+                    v[w]     = u[w] - vr;
+                    v[w + 1] = u[w + 1] - vi;
+                    u[w]     += vr;
+                    u[w + 1] += vi;
+                }
+            }
+        }
+    }
+}
+
+void Fft3d::transform(ThreadPool& pool, bool inverse) {
+    const int nx = n_[0], ny = n_[1], nz = n_[2];
+    const size_t plane = static_cast<size_t>(ny) * nz;
+    Complex* grid = data_.data();
+
+    // z: one contiguous line per (x, y)
+    if (nz > 1) {
+        pool.run(nx, [&](int x, int) {
+            for (int y = 0; y < ny; ++y)
+                transformLines(grid + x * plane + static_cast<size_t>(y) * nz, nz, 1, 1, axes_[2], inverse);
+        });
+    }
+    // y: per x plane, all z columns at once
+    if (ny > 1) {
+        pool.run(nx, [&](int x, int) {
+            transformLines(grid + x * plane, ny, nz, nz, axes_[1], inverse);
+        });
+    }
+    // x: per y row, all z columns at once
+    if (nx > 1) {
+        pool.run(ny, [&](int y, int) {
+            transformLines(grid + static_cast<size_t>(y) * nz, nx, plane, nz, axes_[0], inverse);
+        });
+    }
+}
+#endif
+
+} // namespace physics
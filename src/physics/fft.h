@@ -0,0 +1,59 @@
+#pragma once
+#include "thread_pool.h"
+#include <complex>
+#include <vector>
+
+namespace physics {
+
+/// In-place 3-D complex FFT on an nx × ny × nz grid, z fastest.
+/// Uses FFTW (single precision) when built with PHYSICS_HAVE_FFTW, otherwise
+/// a bundled radix-2 transform run on the thread pool. Neither direction is
+/// normalised.
+class Fft3d {
+public:
+    using Complex = std::complex<float>;
+
+    Fft3d() = default;
+    ~Fft3d();
+    Fft3d(const Fft3d&) = delete;
+    Fft3d& operator=(const Fft3d&) = delete;
+
+    /// Smallest size ≥ n this backend can transform (a power of two for the
+    /// bundled FFT, a 2·3·5·7-smooth number with FFTW).
+    static int goodSize(int n);
+
+    /// Set the grid shape; every dimension must be a goodSize().
+    void resize(int nx, int ny, int nz);
+
+    /// The grid being transformed, index (ix * ny + iy) * nz + iz.
+    std::vector<Complex>& data() { return data_; }
+
+    void forward(ThreadPool& pool) { transform(pool, false); }
+    void inverse(ThreadPool& pool) { transform(pool, true); }
+
+private:
+    int n_[3] = {0, 0, 0};
+    std::vector<Complex> data_;
+
+#ifdef PHYSICS_HAVE_FFTW
+    void* planForward_ = nullptr;
+    void* planInverse_ = nullptr;
+    void destroyPlans();
+#else
+    struct Axis {
+        std::vector<Complex> twiddle;      // e^(-2πik/n), k < n/2
+        std::vector<int> bitReverse;
+    };
+    Axis axes_[3];
+
+    /// Transform `width` interleaved lines at once: element k of line w is
+    /// a[k * stride + w]. Each butterfly stage then streams over contiguous
+    /// memory for the strided x and y axes.
+    static void transformLines(Complex* a, int n, size_t stride, int width,
+                               const Axis& axis, bool inverse);
+#endif
+
+    void transform(ThreadPool& pool, bool inverse);
+};
+
+} // namespace physics
@@ -1,220 +1,295 @@
 #include "interaction.h"
+#include "pair_table.h"
 #include <cmath>
 #include <algorithm>
-#include <sstream>
 
 namespace physics {
 
-// ═══════════════════════════════════════════════════════════
-//  Switching function: smooth force cutoff between switchDist and cutoffDist
-// ═══════════════════════════════════════════════════════════
-float InteractionEngine::switchingFunction(float dist) const {
-    if (dist < switchDist) return 1.0f;
-    if (dist > cutoffDist) return 0.0f;
-    float t = (dist - switchDist) / (cutoffDist - switchDist);
-    // Smooth cubic: 1 - 3t² + 2t³
-    return 1.0f - 3.0f * t * t + 2.0f * t * t * t;
-}
-
 // ═══════════════════════════════════════════════════════════
 //  Morse potential: V(r) = De * (1 - exp(-α(r-re)))²
 //  F(r) = 2*De*α * (1 - exp(-α(r-re))) * exp(-α(r-re)) * r_hat
 // ═══════════════════════════════════════════════════════════
-glm::vec3 InteractionEngine::morseForce(const Atom& a, const Atom& b,
-                                         const Bond& bond, float dist,
-                                         glm::vec3 dir) const {
-    float De = bond.strength;
-    float alpha = bond.morseAlpha;
-    float re = bond.equilibriumDist;
+glm::vec3 InteractionEngine::morseForce(const BondedPairs::Term& bond, float dist,
+                                         glm::vec3 dir, float& energy) {
+    float De = bond.De;
+    float alpha = bond.alpha;
+    float re = bond.re;
     if (De < 1e-6f || dist < 0.1f) return glm::vec3(0);
 
     float expt = std::exp(-alpha * (dist - re));
+    energy += De * (1.0f - expt) * (1.0f - expt);
     float magnitude = 2.0f * De * alpha * (1.0f - expt) * expt;
     return -magnitude * dir; // attractive toward equilibrium
 }
 
+double InteractionEngine::applyBondForces(AtomStore& atoms) const {
+    const Box simBox = box();
+    double energy = 0.0;
+    for (const auto& t : bonded_.terms()) {
+        glm::vec3 diff = simBox.delta(atoms.pos(t.i), atoms.pos(t.j));
+        float dist = glm::length(diff);
+        if (dist < 0.01f || dist > cutoffDist) continue;
+
+        float e = 0.0f;
+        glm::vec3 f = morseForce(t, dist, diff / dist, e);
+        atoms.addForce(t.i, f);
+        atoms.addForce(t.j, -f);
+        energy += e;
+    }
+    return energy;
+}
+
 // ═══════════════════════════════════════════════════════════
-//  Coulomb force: F = k * q1 * q2 / r² with soft core
+//  VSEPR bond angle forces
 // ═══════════════════════════════════════════════════════════
-glm::vec3 InteractionEngine::coulombForce(const Atom& a, const Atom& b,
-                                           float dist, glm::vec3 dir) const {
-    if (a.charge == 0 && b.charge == 0) return glm::vec3(0);
-    float softDist = std::max(dist, 0.5f);
-    float magnitude = coulK * a.charge * b.charge / (softDist * softDist);
-    return magnitude * switchingFunction(dist) * dir;
+double InteractionEngine::applyAngleForces(AtomStore& atoms) {
+    const auto& angles = bonded_.angles();
+    int m = angles.size();
+    if (m == 0) return 0.0;
+
+    AngleKernelInput in;
+    in.x = atoms.x.data(); in.y = atoms.y.data(); in.z = atoms.z.data();
+    in.centre = angles.centre.data();
+    in.a = angles.a.data();
+    in.b = angles.b.data();
+    in.cos0 = angles.cos0.data();
+    in.k = angles.k.data();
+    in.count = m;
+    in.boxLength = periodic ? 2.0f * worldSize : 0.0f;
+
+    angleBuf_.resize(7 * static_cast<size_t>(m));
+    float* f = angleBuf_.data();
+    angleForces(simdLevel, in, f, f + m, f + 2 * m, f + 3 * m, f + 4 * m, f + 5 * m, f + 6 * m);
+
+    // Outer atoms take fa and fb, the centre the reaction
+    double energy = 0.0;
+    for (int t = 0; t < m; ++t) {
+        float fax = f[t], fay = f[m + t], faz = f[2 * m + t];
+        float fbx = f[3 * m + t], fby = f[4 * m + t], fbz = f[5 * m + t];
+        int c = angles.centre[t], a = angles.a[t], b = angles.b[t];
+        atoms.fx[a] += fax; atoms.fy[a] += fay; atoms.fz[a] += faz;
+        atoms.fx[b] += fbx; atoms.fy[b] += fby; atoms.fz[b] += fbz;
+        atoms.fx[c] -= fax + fbx; atoms.fy[c] -= fay + fby; atoms.fz[c] -= faz + fbz;
+        energy += f[6 * m + t];
+    }
+    return energy;
 }
 
 // ═══════════════════════════════════════════════════════════
-//  Lennard-Jones 6-12: V = 4ε[(σ/r)¹² - (σ/r)⁶]
+//  Pair forces for neighbour-list entries [begin, end)
 // ═══════════════════════════════════════════════════════════
-glm::vec3 InteractionEngine::ljForce(const Atom& a, const Atom& b,
-                                      float dist, glm::vec3 dir) const {
-    float sigma = (a.element->vdwRadius + b.element->vdwRadius) / 200.0f; // pm→Å
-    float softDist = std::max(dist, 0.5f);
-    float sr6 = std::pow(sigma / softDist, 6.0f);
-    float magnitude = 24.0f * ljEpsilon * (2.0f * sr6 * sr6 - sr6) / softDist;
-    return magnitude * switchingFunction(dist) * dir;
+double InteractionEngine::pairForceRange(const AtomStore& atoms, int begin, int end,
+                                          float* fx, float* fy, float* fz) {
+    const auto& pairI = neighbors_.pairI();
+    const auto& pairJ = neighbors_.pairJ();
+
+    // Non-bonded LJ + Coulomb (vectorised or tabulated)
+    PairKernelInput in;
+    in.x = atoms.x.data(); in.y = atoms.y.data(); in.z = atoms.z.data();
+    in.charge = charge_.data();
+    in.type = atoms.type.data();
+    in.sigma6 = PairTable::instance().sigma6();
+    in.typeCount = PairTable::instance().typeCount();
+    in.pairI = pairI.data() + begin;
+    in.pairJ = pairJ.data() + begin;
+    in.ljScale = ljScale_.data() + begin;
+    in.count = end - begin;
+    in.ljEpsilon = ljEpsilon;
+    in.coulK = (electrostaticsInUse() == Electrostatics::BarnesHut) ? 0.0f : coulK;
+    in.cutoff = cutoffDist;
+    in.switchDist = switchDist;
+    in.ewaldBeta = ewaldBeta;
+    in.boxLength = periodic ? 2.0f * worldSize : 0.0f;
+    if (pairMode == PairMode::Tabulated)
+        tables_.pairForces(in, pairForce_.data() + begin, pairEnergy_.data() + begin);
+    else
+        nonbondedPairForces(simdLevel, in, pairForce_.data() + begin, pairEnergy_.data() + begin);
+
+    // Scatter pair forces
+    const Box simBox = box();
+    double energy = 0.0;
+    for (int p = begin; p < end; ++p) {
+        int i = pairI[p], j = pairJ[p];
+        glm::vec3 f = pairForce_[p] * simBox.delta(atoms.pos(i), atoms.pos(j));
+        fx[i] += f.x; fy[i] += f.y; fz[i] += f.z;
+        fx[j] -= f.x; fy[j] -= f.y; fz[j] -= f.z; // Newton's third law
+        energy += pairEnergy_[p];
+    }
+    return energy;
 }
 
 // ═══════════════════════════════════════════════════════════
-//  VSEPR bond angle forces
+//  Main force computation
 // ═══════════════════════════════════════════════════════════
-float InteractionEngine::idealBondAngle(int stericNumber) {
-    switch (stericNumber) {
-        case 2: return 180.0f;   // linear
-        case 3: return 120.0f;   // trigonal planar
-        case 4: return 109.47f;  // tetrahedral
-        case 5: return 90.0f;    // trigonal bipyramidal (equatorial-axial)
-        case 6: return 90.0f;    // octahedral
-        default: return 109.47f;
-    }
+void InteractionEngine::reindex(const AtomStore& atoms) {
+    bonded_.rebuild(atoms);
+    neighbors_.invalidate();
 }
 
-void InteractionEngine::applyAngleForces(std::vector<Atom>& atoms) {
-    const float kAngle = 2.0f; // eV/rad² — angle spring constant
-
-    for (size_t i = 0; i < atoms.size(); ++i) {
-        auto& center = atoms[i];
-        int nBonds = static_cast<int>(center.bonds.size());
-        if (nBonds < 2) continue;
-
-        // Steric number = bonds + lone pairs
-        int lonePairs = std::max(0, (center.element->valenceElectrons
-                                     - center.totalBondOrder()) / 2);
-        int stericNumber = nBonds + lonePairs;
-        float idealDeg = idealBondAngle(stericNumber);
-        float idealRad = idealDeg * 3.14159265f / 180.0f;
-
-        // Apply angle restoring force to each pair of bonded neighbors
-        for (int bi = 0; bi < nBonds; ++bi) {
-            for (int bj = bi + 1; bj < nBonds; ++bj) {
-                int idxA = center.bonds[bi].otherAtomIdx;
-                int idxB = center.bonds[bj].otherAtomIdx;
-                if (idxA < 0 || idxB < 0) continue;
-                if (idxA >= (int)atoms.size() || idxB >= (int)atoms.size()) continue;
-
-                glm::vec3 rA = atoms[idxA].pos - center.pos;
-                glm::vec3 rB = atoms[idxB].pos - center.pos;
-                float lenA = glm::length(rA);
-                float lenB = glm::length(rB);
-                if (lenA < 0.01f || lenB < 0.01f) continue;
-
-                rA /= lenA;
-                rB /= lenB;
-                float cosAngle = glm::clamp(glm::dot(rA, rB), -1.0f, 1.0f);
-                float angle = std::acos(cosAngle);
-                float dAngle = angle - idealRad;
-
-                // Torque → force on outer atoms
-                // Force perpendicular to bond direction
-                float forceMag = kAngle * dAngle;
-
-                // Perpendicular components
-                glm::vec3 perpA = rB - cosAngle * rA;
-                float perpAlen = glm::length(perpA);
-                if (perpAlen > 0.001f) {
-                    perpA /= perpAlen;
-                    atoms[idxA].force += forceMag / lenA * perpA;
-                    center.force -= forceMag / lenA * perpA;
-                }
+void InteractionEngine::computeForces(AtomStore& atoms, ForceGroup group) {
+    atoms.clearForces();
+    if (!bonded_.current(atoms)) bonded_.rebuild(atoms);
 
-                glm::vec3 perpB = rA - cosAngle * rB;
-                float perpBlen = glm::length(perpB);
-                if (perpBlen > 0.001f) {
-                    perpB /= perpBlen;
-                    atoms[idxB].force += forceMag / lenB * perpB;
-                    center.force -= forceMag / lenB * perpB;
-                }
-            }
+    if (group != ForceGroup::Bonded)
+        nonbondedPE = static_cast<float>(computeNonbondedForces(atoms));
+
+    // Bonded Morse terms (one pass over the bond list) and VSEPR angles
+    // over the precomputed triplets
+    if (group != ForceGroup::Nonbonded)
+        bondedPE = static_cast<float>(applyBondForces(atoms) + applyAngleForces(atoms));
+
+    totalPE = bondedPE + nonbondedPE;
+}
+
+double InteractionEngine::computeNonbondedForces(AtomStore& atoms) {
+    // Pair candidates come from the persistent Verlet list
+    bool listRebuilt = neighbors_.update(atoms, box(), cutoffDist, neighborSkin);
+    if (listRebuilt) neighborRebuildCount++;
+
+    int n = atoms.size();
+    int nPairs = neighbors_.pairCount();
+
+    // Bonded pairs get Morse instead of LJ. Exclusion flags only change
+    // when the list or the bond topology does.
+    if (listRebuilt || ljScaleVersion_ != bonded_.version()) {
+        const auto& pairI = neighbors_.pairI();
+        const auto& pairJ = neighbors_.pairJ();
+        ljScale_.resize(nPairs);
+        for (int p = 0; p < nPairs; ++p)
+            ljScale_[p] = bonded_.contains(pairI[p], pairJ[p]) ? 0.0f : 1.0f;
+        ljScaleVersion_ = bonded_.version();
+    }
+
+    // Per-atom charges (the only kernel input that lives in the records)
+    charge_.resize(n);
+    for (int i = 0; i < n; ++i)
+        charge_[i] = static_cast<float>(atoms[i].charge);
+
+    // Ewald splitting for the real-space part of PME
+    PmeSolver::Settings pmeSettings;
+    pmeSettings.cutoff = cutoffDist;
+    pmeSettings.tolerance = pmeTolerance;
+    pmeSettings.spacing = pmeSpacing;
+    pmeSettings.order = pmeOrder;
+    ewaldBeta = (electrostaticsInUse() == Electrostatics::PME)
+              ? PmeSolver::ewaldBeta(cutoffDist, pmeTolerance) : 0.0f;
+
+    // Tables cover every species pair present; rebuilt when species or
+    // potential parameters change
+    if (pairMode == PairMode::Tabulated) {
+        present_.assign(PairTable::instance().typeCount(), 0);
+        for (int t : atoms.type) present_[t] = 1;
+        PotentialTable::Settings settings;
+        settings.ljEpsilon = ljEpsilon;
+        settings.coulK = (electrostaticsInUse() == Electrostatics::BarnesHut) ? 0.0f : coulK;
+        settings.cutoff = cutoffDist;
+        settings.switchDist = switchDist;
+        settings.tableBits = tableBits;
+        settings.ewaldBeta = ewaldBeta;
+        if (tables_.update(present_, settings)) {
+            tableMaxAbsError = tables_.maxAbsForceError();
+            tableMaxRelError = tables_.maxRelForceError();
         }
     }
-}
 
-// ═══════════════════════════════════════════════════════════
-//  Main force computation
-// ═══════════════════════════════════════════════════════════
-void InteractionEngine::computeForces(std::vector<Atom>& atoms) {
-    for (auto& a : atoms) a.force = glm::vec3(0.0f);
-    totalPE = 0;
-    totalKE = 0;
-
-    int n = static_cast<int>(atoms.size());
-    for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            glm::vec3 diff = atoms[i].pos - atoms[j].pos;
-            float dist = glm::length(diff);
-            if (dist < 0.01f || dist > cutoffDist) continue;
-            glm::vec3 dir = diff / dist;
-
-            // Check if bonded
-            const Bond* bond = nullptr;
-            for (const auto& b : atoms[i].bonds) {
-                if (b.otherAtomIdx == j) { bond = &b; break; }
+    // Pair pass, split into contiguous pair ranges. Each range accumulates
+    // into a private force buffer; buffers are then summed per atom in a
+    // fixed order.
+    pool_.resize(threads);
+    pairForce_.resize(nPairs);
+    pairEnergy_.resize(nPairs);
+
+    double pairPE = 0.0;
+    if (!deterministic && pool_.size() == 1) {
+        pairPE = pairForceRange(atoms, 0, nPairs, atoms.fx.data(), atoms.fy.data(), atoms.fz.data());
+    } else {
+        // Deterministic: one buffer per fixed range, so the summation order
+        // is independent of thread count and scheduling. Otherwise: one
+        // buffer per worker, with ranges handed out dynamically.
+        int ranges  = deterministic ? kDeterministicRanges : 4 * pool_.size();
+        int buffers = deterministic ? kDeterministicRanges : pool_.size();
+        forceBuf_.resize(buffers);
+        for (auto& buf : forceBuf_) buf.assign(3 * n, 0.0f);
+        rangePE_.assign(ranges, 0.0);
+
+        pool_.run(ranges, [&](int r, int worker) {
+            auto& buf = forceBuf_[deterministic ? r : worker];
+            int begin = static_cast<int>(static_cast<long long>(nPairs) * r / ranges);
+            int end   = static_cast<int>(static_cast<long long>(nPairs) * (r + 1) / ranges);
+            rangePE_[r] = pairForceRange(atoms, begin, end, buf.data(), buf.data() + n, buf.data() + 2 * n);
+        });
+        for (double e : rangePE_) pairPE += e;
+
+        // Parallel reduction over atom blocks, buffers summed in index order
+        int blocks = pool_.size();
+        pool_.run(blocks, [&](int blk, int) {
+            int begin = n * blk / blocks, end = n * (blk + 1) / blocks;
+            for (const auto& buf : forceBuf_) {
+                for (int i = begin; i < end; ++i) {
+                    atoms.fx[i] += buf[i];
+                    atoms.fy[i] += buf[n + i];
+                    atoms.fz[i] += buf[2 * n + i];
+                }
             }
+        });
+    }
 
-            glm::vec3 f(0.0f);
-            if (bond) {
-                // Bonded: Morse potential
-                f += morseForce(atoms[i], atoms[j], *bond, dist, dir);
-            } else {
-                // Non-bonded: LJ van der Waals
-                f += ljForce(atoms[i], atoms[j], dist, dir);
-            }
-            // Coulomb always (for charged species)
-            f += coulombForce(atoms[i], atoms[j], dist, dir);
+    double energy = pairPE;
 
-            atoms[i].force += f;
-            atoms[j].force -= f; // Newton's third law
-        }
+    // Reciprocal-space Ewald sum
+    if (electrostaticsInUse() == Electrostatics::PME) {
+        energy += pme_.compute(atoms, charge_, worldSize, coulK, pmeSettings, pool_);
+        pmeMeshSize = pme_.meshSize();
+    }
 
-        // Kinetic energy
-        float v2 = glm::dot(atoms[i].vel, atoms[i].vel);
-        atoms[i].kineticEnergy = 0.5f * atoms[i].mass * v2;
-        totalKE += atoms[i].kineticEnergy;
+    // Open-boundary Coulomb over all charged pairs, no cutoff
+    if (electrostaticsInUse() == Electrostatics::BarnesHut) {
+        BarnesHutSolver::Settings bhSettings;
+        bhSettings.theta = bhTheta;
+        bhSettings.leafSize = bhLeafSize;
+        energy += bh_.compute(atoms, charge_, coulK, bhSettings, pool_);
+        if (bhCheckInterval > 0 && bhEvalCount_++ % bhCheckInterval == 0)
+            bhForceError = bh_.sampleError(coulK, bhCheckSamples);
     }
 
-    // VSEPR angle forces
-    applyAngleForces(atoms);
+    return energy;
 }
 
 // ═══════════════════════════════════════════════════════════
 //  Emergent bond energy estimation
 // ═══════════════════════════════════════════════════════════
 float InteractionEngine::estimateBondEnergy(const Atom& a, const Atom& b,
-                                             Bond::Type type, int order) const {
+                                             Bond::Type type, int order,
+                                             float dist) const {
     if (type == Bond::IONIC) {
         // Born-Haber: lattice energy approximation
-        float dist = glm::length(a.pos - b.pos);
         return std::abs(coulK / std::max(dist, 1.0f));
     }
-    // Covalent: geometric mean of ionization energies scaled by order
-    float IE_A = a.element->ionizationEnergy;
-    float IE_B = b.element->ionizationEnergy;
-    float EA_A = std::max(a.element->electronAffinity, 0.1f);
-    float EA_B = std::max(b.element->electronAffinity, 0.1f);
-    float baseBondE = std::sqrt(EA_A * EA_B) + std::sqrt(IE_A * IE_B) * 0.1f;
-    return baseBondE * order;
+    // Covalent: per-pair single-bond energy (see PairTable) scaled by order
+    return PairTable::instance().get(a.elementZ, b.elementZ).covalentE * order;
 }
 
 // ═══════════════════════════════════════════════════════════
 //  Ionic bonding — Born-Haber cycle energy check
 // ═══════════════════════════════════════════════════════════
-bool InteractionEngine::tryIonicBond(Atom& a, Atom& b, int idxA, int idxB) {
+bool InteractionEngine::planIonicBond(const AtomStore& atoms, int idxA, int idxB,
+                                      float dist, Bond& bond) const {
+    const Atom& a = atoms[idxA];
+    const Atom& b = atoms[idxB];
+
     // Determine donor (low χ) and acceptor (high χ)
-    Atom* donor   = (a.element->electronegativity < b.element->electronegativity) ? &a : &b;
-    Atom* acceptor= (donor == &a) ? &b : &a;
-    int donorIdx  = (donor == &a) ? idxA : idxB;
-    int accIdx    = (donor == &a) ? idxB : idxA;
+    bool aDonates = a.element->electronegativity < b.element->electronegativity;
+    const Atom& donor    = aDonates ? a : b;
+    const Atom& acceptor = aDonates ? b : a;
 
-    if (!donor->wantsToLoseElectron()) return false;
-    if (!acceptor->wantsElectron())    return false;
+    if (!donor.wantsToLoseElectron()) return false;
+    if (!acceptor.wantsElectron())    return false;
 
     // Born-Haber cycle energy check:
     // ΔE = IE(donor) - EA(acceptor) - Coulomb_stabilization
-    float dist = glm::length(a.pos - b.pos);
+    const PairParams& params = PairTable::instance().get(a.elementZ, b.elementZ);
     float coulombStab = coulK / std::max(dist, 0.5f);
-    float deltaE = donor->element->ionizationEnergy -
-                   acceptor->element->electronAffinity - coulombStab;
+    float deltaE = params.ionicDeltaE - coulombStab;
 
     if (deltaE > 0) return false; // endothermic — no bond
 
@@ -222,40 +297,26 @@ bool InteractionEngine::tryIonicBond(Atom& a, Atom& b, int idxA, int idxB) {
     float thermalE = kB * temperature;
     if (std::abs(deltaE) < thermalE * 2.0f) return false;
 
-    // Transfer electron!
-    Electron e = donor->removeOuterElectron();
-    acceptor->addElectron(e);
-
     float bondE = std::abs(deltaE);
-    float eqDist = (donor->element->covalentRadius + acceptor->element->covalentRadius) / 100.0f;
+    float eqDist = params.covalentRe;
     float alpha = std::sqrt(5.0f / (2.0f * std::max(bondE, 0.1f)));
 
-    Bond bondA; bondA.otherAtomIdx = accIdx; bondA.type = Bond::IONIC;
-    bondA.order = 1; bondA.strength = bondE;
-    bondA.equilibriumDist = eqDist; bondA.morseAlpha = alpha;
-
-    Bond bondB; bondB.otherAtomIdx = donorIdx; bondB.type = Bond::IONIC;
-    bondB.order = 1; bondB.strength = bondE;
-    bondB.equilibriumDist = eqDist; bondB.morseAlpha = alpha;
+    bond.atomA = aDonates ? idxA : idxB; bond.atomB = aDonates ? idxB : idxA;
+    bond.type = Bond::IONIC;
+    bond.order = 1; bond.strength = bondE;
+    bond.equilibriumDist = eqDist; bond.morseAlpha = alpha;
 
-    donor->bonds.push_back(bondA);
-    acceptor->bonds.push_back(bondB);
-    totalBondE += bondE;
-    bondFormedCount++;
-
-    // Log reaction
-    std::ostringstream oss;
-    oss << donor->element->symbol << " + " << acceptor->element->symbol
-        << " -> ionic bond (dE=" << -deltaE << "eV)";
-    reactionLog.push_back({simTime, oss.str()});
-
-    return true;
+    return !(formStableOnly && shouldBreakBond(a, b, bond, dist));
 }
 
 // ═══════════════════════════════════════════════════════════
 //  Covalent bonding — orbital overlap energy check
 // ═══════════════════════════════════════════════════════════
-bool InteractionEngine::tryCovalentBond(Atom& a, Atom& b, int idxA, int idxB) {
+bool InteractionEngine::planCovalentBond(const AtomStore& atoms, int idxA, int idxB,
+                                         float dist, Bond& bond) const {
+    const Atom& a = atoms[idxA];
+    const Atom& b = atoms[idxB];
+
     int availA = a.availableValenceElectrons();
     int availB = b.availableValenceElectrons();
     if (availA <= 0 || availB <= 0) return false;
@@ -263,15 +324,14 @@ bool InteractionEngine::tryCovalentBond(Atom& a, Atom& b, int idxA, int idxB) {
     // Bond order = min available, capped at 3
     int order = std::min({availA, availB, 3});
 
-    float dist = glm::length(a.pos - b.pos);
-    float eqDist = (a.element->covalentRadius + b.element->covalentRadius) / 100.0f;
+    float eqDist = PairTable::instance().get(a.elementZ, b.elementZ).covalentRe;
 
     // Overlap factor: bonds more favorable near equilibrium distance
     float overlapSigma = eqDist * 0.5f;
     float overlapFactor = std::exp(-(dist - eqDist) * (dist - eqDist) /
                                     (overlapSigma * overlapSigma));
 
-    float bondE = estimateBondEnergy(a, b, Bond::COVALENT, order) * overlapFactor;
+    float bondE = estimateBondEnergy(a, b, Bond::COVALENT, order, dist) * overlapFactor;
 
     // Must be energetically favorable and thermally stable
     float thermalE = kB * temperature;
@@ -279,29 +339,48 @@ bool InteractionEngine::tryCovalentBond(Atom& a, Atom& b, int idxA, int idxB) {
 
     float alpha = std::sqrt(5.0f / (2.0f * std::max(bondE, 0.1f)));
 
-    Bond bondA; bondA.otherAtomIdx = idxB; bondA.type = Bond::COVALENT;
-    bondA.order = order; bondA.strength = bondE;
-    bondA.equilibriumDist = eqDist; bondA.morseAlpha = alpha;
+    bond.atomA = idxA; bond.atomB = idxB; bond.type = Bond::COVALENT;
+    bond.order = order; bond.strength = bondE;
+    bond.equilibriumDist = eqDist; bond.morseAlpha = alpha;
+    return !(formStableOnly && shouldBreakBond(a, b, bond, dist));
+}
 
-    Bond bondB; bondB.otherAtomIdx = idxA; bondB.type = Bond::COVALENT;
-    bondB.order = order; bondB.strength = bondE;
-    bondB.equilibriumDist = eqDist; bondB.morseAlpha = alpha;
+bool InteractionEngine::planBond(const AtomStore& atoms, int i, int j, float dist,
+                                 Bond& bond) const {
+    // Electronegativity difference determines bond type
+    float deltaChi = std::abs(atoms[i].element->electronegativity -
+                              atoms[j].element->electronegativity);
+    return deltaChi > ionicThreshold ? planIonicBond(atoms, i, j, dist, bond)
+                                     : planCovalentBond(atoms, i, j, dist, bond);
+}
 
-    a.bonds.push_back(bondA);
-    b.bonds.push_back(bondB);
-    a.updateEffectiveValence();
-    b.updateEffectiveValence();
-    totalBondE += bondE;
-    bondFormedCount++;
+void InteractionEngine::formBond(AtomStore& atoms, const Bond& bond) {
+    Atom& a = atoms[bond.atomA];
+    Atom& b = atoms[bond.atomB];
 
-    // Log
-    std::ostringstream oss;
-    std::string orderStr = (order == 1) ? "single" : (order == 2) ? "double" : "triple";
-    oss << a.element->symbol << " + " << b.element->symbol
-        << " -> " << orderStr << " covalent bond (E=" << bondE << "eV)";
-    reactionLog.push_back({simTime, oss.str()});
+    // Transfer electron! (ionic bonds run donor → acceptor)
+    if (bond.type == Bond::IONIC) {
+        Electron e = a.removeOuterElectron();
+        b.addElectron(e);
+    }
+    atoms.addBond(bond);
+    if (bond.type == Bond::COVALENT) {
+        a.updateEffectiveValence();
+        b.updateEffectiveValence();
+    }
+    totalBondE += bond.strength;
+    bondFormedCount++;
+    reactedAtoms_.push_back(bond.atomA);
+    reactedAtoms_.push_back(bond.atomB);
 
-    return true;
+    // Log reaction
+    ReactionEvent event;
+    event.time = simTime; event.kind = ReactionEvent::Formed;
+    event.idA = atoms.id(bond.atomA); event.idB = atoms.id(bond.atomB);
+    event.zA = static_cast<uint8_t>(a.elementZ); event.zB = static_cast<uint8_t>(b.elementZ);
+    event.bondType = static_cast<uint8_t>(bond.type); event.order = static_cast<uint8_t>(bond.order);
+    event.energy = bond.strength; event.temperature = temperature;
+    reactionLog.push(event);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -334,81 +413,188 @@ bool InteractionEngine::shouldBreakBond(const Atom& a, const Atom& b,
 // ═══════════════════════════════════════════════════════════
 //  Bond update loop
 // ═══════════════════════════════════════════════════════════
-void InteractionEngine::updateBonds(std::vector<Atom>& atoms) {
-    int n = static_cast<int>(atoms.size());
+static bool bondedTo(const BondTable& table, int i, int j) {
+    if (table.degree(j) < table.degree(i)) std::swap(i, j);
+    for (const auto& e : table.of(i))
+        if (e.otherAtomIdx == j) return true;
+    return false;
+}
+
+void InteractionEngine::updateBonds(AtomStore& atoms, const std::vector<char>* active) {
+    int n = atoms.size();
+    const Box simBox = box();
+    auto isActive = [&](int i) { return !active || (*active)[i]; };
+    reactedAtoms_.clear();
+
+    // Atoms whose bonds phase 1 walks: all, or the active atoms and the
+    // lower-index partners that own their bonds
+    const BondTable& table = atoms.bonds();
+    bondOwners_.clear();
+    if (active) {
+        for (int i = 0; i < n; ++i) {
+            if (!(*active)[i]) continue;
+            bondOwners_.push_back(i);
+            for (const auto& e : table.of(i))
+                if (e.otherAtomIdx < i) bondOwners_.push_back(e.otherAtomIdx);
+        }
+        std::sort(bondOwners_.begin(), bondOwners_.end());
+        bondOwners_.erase(std::unique(bondOwners_.begin(), bondOwners_.end()), bondOwners_.end());
+    }
+    int owners = active ? static_cast<int>(bondOwners_.size()) : n;
 
     // ── Phase 1: Break bonds ──
-    for (int i = 0; i < n; ++i) {
-        auto& bondList = atoms[i].bonds;
-        for (auto it = bondList.begin(); it != bondList.end(); ) {
-            int j = it->otherAtomIdx;
-            if (j < 0 || j >= n) { it = bondList.erase(it); continue; }
-            float dist = glm::length(atoms[i].pos - atoms[j].pos);
-
-            if (shouldBreakBond(atoms[i], atoms[j], *it, dist)) {
-                // Remove from partner
-                auto& otherBonds = atoms[j].bonds;
-                otherBonds.erase(
-                    std::remove_if(otherBonds.begin(), otherBonds.end(),
-                        [i](const Bond& b){ return b.otherAtomIdx == i; }),
-                    otherBonds.end());
-
-                // If ionic, return electron
-                if (it->type == Bond::IONIC && atoms[i].charge > 0) {
-                    if (!atoms[j].electrons.empty()) {
-                        Electron e = atoms[j].removeOuterElectron();
-                        atoms[i].addElectron(e);
-                    }
+    // Each bond is checked once, from its lower-index atom. Removal
+    // swap-fills edge k, so k only advances past kept bonds.
+    for (int o = 0; o < owners; ++o) {
+        int i = active ? bondOwners_[o] : o;
+        for (int k = 0; k < table.degree(i); ) {
+            BondTable::Edge edge = table.of(i)[k];
+            int j = edge.otherAtomIdx;
+            if (j < i || !(isActive(i) || isActive(j))) { ++k; continue; }
+            const Bond& bond = table[edge.bond];
+            float dist = glm::length(simBox.delta(atoms.pos(i), atoms.pos(j)));
+            if (!shouldBreakBond(atoms[i], atoms[j], bond, dist)) { ++k; continue; }
+
+            Bond::Type type = bond.type;
+            int order = bond.order;
+            float strength = bond.strength;
+            int donor = bond.atomA, acceptor = bond.atomB;
+            atoms.removeBond(edge.bond);
+
+            // If ionic, return electron (ionic bonds run donor → acceptor)
+            if (type == Bond::IONIC && atoms[donor].charge > 0) {
+                if (!atoms[acceptor].electrons.empty()) {
+                    Electron e = atoms[acceptor].removeOuterElectron();
+                    atoms[donor].addElectron(e);
                 }
-
-                // Log
-                std::ostringstream oss;
-                oss << atoms[i].element->symbol << "-" << atoms[j].element->symbol
-                    << " bond broken (T=" << temperature << "K)";
-                reactionLog.push_back({simTime, oss.str()});
-
-                totalBondE -= it->strength;
-                bondBrokenCount++;
-                it = bondList.erase(it);
-            } else {
-                ++it;
             }
+
+            // Log
+            ReactionEvent event;
+            event.time = simTime; event.kind = ReactionEvent::Broken;
+            event.idA = atoms.id(i); event.idB = atoms.id(j);
+            event.zA = static_cast<uint8_t>(atoms[i].elementZ);
+            event.zB = static_cast<uint8_t>(atoms[j].elementZ);
+            event.bondType = static_cast<uint8_t>(type); event.order = static_cast<uint8_t>(order);
+            event.energy = strength; event.temperature = temperature;
+            reactionLog.push(event);
+
+            totalBondE -= strength;
+            bondBrokenCount++;
+            reactedAtoms_.push_back(i);
+            reactedAtoms_.push_back(j);
         }
     }
 
+
     // ── Phase 2: Form new bonds ──
-    for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            float dist = glm::length(atoms[i].pos - atoms[j].pos);
-            if (dist > bondingRange) continue;
-
-            // Skip if already bonded
-            bool alreadyBonded = false;
-            for (const auto& b : atoms[i].bonds)
-                if (b.otherAtomIdx == j) { alreadyBonded = true; break; }
-            if (alreadyBonded) continue;
-
-            // Skip noble gases (octet complete, no bonding tendency)
-            if (atoms[i].element->category == "noble_gas" ||
-                atoms[j].element->category == "noble_gas") continue;
-
-            float chiA = atoms[i].element->electronegativity;
-            float chiB = atoms[j].element->electronegativity;
-            if (chiA < 0.01f || chiB < 0.01f) continue;
-
-            float deltaChi = std::abs(chiA - chiB);
-
-            // Electronegativity difference determines bond type
-            if (deltaChi > ionicThreshold) {
-                tryIonicBond(atoms[i], atoms[j], i, j);
-            } else {
-                tryCovalentBond(atoms[i], atoms[j], i, j);
-            }
+    // Candidates within bondingRange come from a cell grid. A partial
+    // update takes the pairs around each active atom, once per pair.
+    auto addCandidate = [&](int i, int j) {
+        if (i > j) std::swap(i, j);
+        if (glm::length(simBox.delta(atoms.pos(i), atoms.pos(j))) > bondingRange) return;
+        bondCandidates_.push_back((static_cast<uint64_t>(i) << 32) | static_cast<uint32_t>(j));
+    };
+    bondGrid_.build(atoms, simBox, bondingRange);
+    bondCandidates_.clear();
+    if (!active) {
+        bondGrid_.forEachPair(addCandidate);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            if (!(*active)[i]) continue;
+            bondGrid_.forEachNeighbor(i, [&](int j) {
+                if (!(*active)[j] || i < j) addCandidate(i, j);
+            });
         }
     }
 
-    // Update effective valences
-    for (auto& a : atoms) a.updateEffectiveValence();
+    // Score every candidate against the post-break state, in parallel:
+    // each pair only reads the atoms, so the scores don't depend on the
+    // thread count. Score = energy the bond would release (0: none).
+    const PeriodicTable& periodic = PeriodicTable::instance();
+    int nCandidates = static_cast<int>(bondCandidates_.size());
+    bondScores_.resize(nCandidates);
+    if (nCandidates > 0) {
+        pool_.resize(threads);
+        int ranges = std::min(nCandidates, 4 * pool_.size());
+        pool_.run(ranges, [&](int r, int) {
+            int begin = static_cast<int>(static_cast<long long>(nCandidates) * r / ranges);
+            int end   = static_cast<int>(static_cast<long long>(nCandidates) * (r + 1) / ranges);
+            for (int c = begin; c < end; ++c) {
+                int i = static_cast<int>(bondCandidates_[c] >> 32);
+                int j = static_cast<int>(bondCandidates_[c] & 0xffffffffu);
+                bondScores_[c] = 0.0f;
+
+                // Skip noble gases (octet complete, no bonding tendency)
+                // and elements without an electronegativity
+                if (!(periodic.traits(atoms.type[i]) & periodic.traits(atoms.type[j]) & CanBond)) continue;
+                if (bondedTo(table, i, j)) continue;
+
+                float dist = glm::length(simBox.delta(atoms.pos(i), atoms.pos(j)));
+                Bond bond;
+                if (planBond(atoms, i, j, dist, bond)) bondScores_[c] = bond.strength;
+            }
+        });
+    }
+
+    // Resolve competition for electrons and valence: strongest bonds
+    // first, ties broken by atom ID, so the outcome doesn't depend on the
+    // atom order either. Each pair is planned again against the bonds
+    // formed so far (its order can drop, or it can no longer bond).
+    bondProposals_.clear();
+    for (int c = 0; c < nCandidates; ++c) {
+        if (bondScores_[c] <= 0.0f) continue;
+        int i = static_cast<int>(bondCandidates_[c] >> 32);
+        int j = static_cast<int>(bondCandidates_[c] & 0xffffffffu);
+        int idI = atoms.id(i), idJ = atoms.id(j);
+        uint64_t ids = (static_cast<uint64_t>(std::min(idI, idJ)) << 32) |
+                       static_cast<uint32_t>(std::max(idI, idJ));
+        bondProposals_.push_back({bondScores_[c], ids, i, j});
+    }
+    std::sort(bondProposals_.begin(), bondProposals_.end(),
+              [](const BondProposal& p, const BondProposal& q) {
+                  return p.score != q.score ? p.score > q.score : p.ids < q.ids;
+              });
+    for (const BondProposal& p : bondProposals_) {
+        float dist = glm::length(simBox.delta(atoms.pos(p.i), atoms.pos(p.j)));
+        Bond bond;
+        if (planBond(atoms, p.i, p.j, dist, bond)) formBond(atoms, bond);
+    }
+
+    // Update effective valences (only reacting atoms' can have changed)
+    if (active) {
+        for (int i : reactedAtoms_) atoms[i].updateEffectiveValence();
+    } else {
+        for (auto& a : atoms) a.updateEffectiveValence();
+    }
+
+    // The terms only change with the topology, so an update without
+    // events keeps their version (and the pair exclusions built from it)
+    if (!bonded_.current(atoms)) bonded_.rebuild(atoms);
+}
+
+int InteractionEngine::markBreakingBonds(const AtomStore& atoms, std::vector<char>& flags) const {
+    const Box simBox = box();
+    const BondTable& table = atoms.bonds();
+
+    // shouldBreakBond in closed form, without exp: the Boltzmann test is
+    // De < 3kT·ln 2, and the Morse test |1 − e^{−α(r−rₑ)}| > √0.9 holds
+    // outside −0.6671 < α(r − rₑ) < 2.9697
+    const float thermalDe = 3.0f * kB * temperature * 0.693147f;
+    int count = 0;
+    for (int slot = 0; slot < table.slots(); ++slot) {
+        const Bond& bond = table[slot];
+        if (bond.atomA < 0) continue;
+        float re = bond.equilibriumDist, invAlpha = 1.0f / bond.morseAlpha;
+        float lo = re - 0.6671f * invAlpha;
+        float hi = std::min(re + 2.9697f * invAlpha, 2.5f * re);
+        glm::vec3 d = simBox.delta(atoms.pos(bond.atomA), atoms.pos(bond.atomB));
+        float r2 = glm::dot(d, d);
+        if (bond.strength >= thermalDe && r2 < hi * hi && (lo <= 0.0f || r2 > lo * lo)) continue;
+        flags[bond.atomA] = flags[bond.atomB] = 1;
+        ++count;
+    }
+    return count;
 }
 
 } // namespace physics
@@ -1,5 +1,15 @@
 #pragma once
-#include "atom.h"
+#include "atom_store.h"
+#include "barnes_hut.h"
+#include "bonded_pairs.h"
+#include "box.h"
+#include "cell_grid.h"
+#include "neighbor_list.h"
+#include "pair_kernel.h"
+#include "pme.h"
+#include "potential_table.h"
+#include "reaction_log.h"
+#include "thread_pool.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
@@ -10,11 +20,36 @@ namespace physics {
 /// No predefined reaction tables — chemistry is computed from first principles.
 class InteractionEngine {
 public:
-    /// Compute all pairwise forces and update atom.force vectors.
-    void computeForces(std::vector<Atom>& atoms);
+    /// Force groups that can be evaluated separately (for multiple time
+    /// stepping): bonded = Morse + VSEPR angles; non-bonded = LJ, Coulomb
+    /// and any long-range electrostatics.
+    enum class ForceGroup { All, Bonded, Nonbonded };
 
-    /// Check for bond formation/breaking based on energy criteria.
-    void updateBonds(std::vector<Atom>& atoms);
+    /// Compute the forces of one group (default: all) into the store's
+    /// force arrays, replacing their contents.
+    void computeForces(AtomStore& atoms, ForceGroup group = ForceGroup::All);
+
+    /// Check for bond formation/breaking based on energy criteria. With
+    /// `active`, only bonds and candidate pairs with at least one atom
+    /// flagged in it are checked.
+    void updateBonds(AtomStore& atoms, const std::vector<char>* active = nullptr);
+
+    /// Flag both atoms of every bond that updateBonds would break now.
+    /// Returns the number of such bonds. Changes nothing else.
+    int markBreakingBonds(const AtomStore& atoms, std::vector<char>& flags) const;
+
+    /// Atoms that formed or broke a bond in the last updateBonds().
+    const std::vector<int>& reactedAtoms() const { return reactedAtoms_; }
+
+    /// Atoms were removed or reordered: rebuild the index-based caches
+    /// (bond terms, neighbour list) for the new layout.
+    void reindex(const AtomStore& atoms);
+
+    /// Bond terms as of the last force evaluation or bond update.
+    const BondedPairs& bonded() const { return bonded_; }
+
+    /// Worker pool, sized to `threads`, for other per-step passes.
+    ThreadPool& pool() { pool_.resize(threads); return pool_; }
 
     // Simulation parameters
     float temperature      = 300.0f;   // Kelvin
@@ -27,55 +62,138 @@ public:
     // Tuning
     float bondingRange     = 5.0f;     // Å — max distance to attempt bonding
     float ionicThreshold   = 1.7f;     // Δχ above which → ionic bond
+    bool  formStableOnly   = false;    // don't form bonds the next check would break
     float ljEpsilon        = 0.01f;    // eV (LJ well depth baseline)
     float cutoffDist       = 20.0f;    // Å — force cutoff
     float switchDist       = 15.0f;    // Å — start smoothing to zero
+    float neighborSkin     = 2.0f;     // Å — Verlet list margin beyond cutoff
+    SimdLevel simdLevel    = detectSimdLevel(); // pair kernel ISA (clamped to CPU)
+
+    // Non-bonded evaluation: analytic kernel or r²-interpolated tables
+    enum class PairMode { Analytic, Tabulated };
+    PairMode pairMode      = PairMode::Analytic;
+    int tableBits          = 7;        // table nodes per octave of r² = 2^tableBits
+
+    // Long-range electrostatics: cubic-switched Coulomb truncated at
+    // cutoffDist, particle-mesh Ewald (real-space erfc part within
+    // cutoffDist, which can then be ~10 Å; needs periodic, otherwise
+    // Switched is used), or an untruncated Barnes–Hut tree sum for open
+    // boundaries (ignores periodic; the pair kernel then does LJ only)
+    enum class Electrostatics { Switched, PME, BarnesHut };
+    Electrostatics electrostatics = Electrostatics::Switched;
+    float pmeTolerance     = 1e-5f;    // erfc(β·cutoffDist) at the real-space cutoff
+    float pmeSpacing       = 1.0f;     // Å — max PME mesh spacing
+    int   pmeOrder         = 4;        // B-spline order (4 = cubic)
+    float bhTheta          = 0.5f;     // Barnes–Hut opening angle
+    int   bhLeafSize       = 8;        // max charges per tree leaf
+    int   bhCheckInterval  = 0;        // evaluations between direct-sum checks (0 = off)
+    int   bhCheckSamples   = 64;       // atoms sampled per check
+
+    // Parallelism
+    int  threads           = 1;        // worker threads for the force pass and bond scoring
+    bool deterministic     = false;    // bitwise-reproducible for any thread count
+    static constexpr int kDeterministicRanges = 16;
+
+    // Box half-width (Å) and boundary mode, kept in sync by Simulation.
+    // Periodic: all separations use the minimum image, which needs
+    // cutoffDist + neighborSkin ≤ worldSize.
+    float worldSize        = 50.0f;
+    bool  periodic         = false;
 
     // Statistics
-    float totalKE = 0, totalPE = 0, totalBondE = 0;
+    float totalKE = 0, totalPE = 0, totalBondE = 0; // KE is set by the integrator
+    float bondedPE = 0, nonbondedPE = 0;   // per group, latest evaluation; sum = totalPE
     int bondFormedCount = 0, bondBrokenCount = 0;
-
-    // Reaction log
-    struct ReactionEvent {
-        float time = 0;
-        std::string description;
-    };
-    std::vector<ReactionEvent> reactionLog;
+    int neighborRebuildCount = 0;
+    float tableMaxAbsError = 0;        // eV/Å — tabulated vs analytic, last build
+    float tableMaxRelError = 0;        // relative, same sampling
+    float ewaldBeta = 0;               // 1/Å — Ewald splitting in use (0 = Switched)
+    int pmeMeshSize = 0;               // PME mesh points per axis
+    float bhForceError = 0;            // RMS relative tree force error, last check
+
+    // Reaction log: bounded, formatted only when read
+    ReactionLog reactionLog;
     float simTime = 0;
 
 private:
+    NeighborList neighbors_;
+    BondedPairs  bonded_;
+    CellGrid     bondGrid_;                       // bond-formation candidate search
+    std::vector<uint64_t> bondCandidates_;        // (i << 32) | j, i < j
+    std::vector<float> bondScores_;               // per candidate: bond energy, 0 = none
+
+    /// A candidate that can bond, ordered by score then by atom IDs.
+    struct BondProposal {
+        float    score;
+        uint64_t ids;                             // (min ID << 32) | max ID
+        int      i, j;
+    };
+    std::vector<BondProposal> bondProposals_;
+    std::vector<int> reactedAtoms_;               // last updateBonds()
+    std::vector<int> bondOwners_;                 // partial update: atoms phase 1 walks
+    unsigned     ljScaleVersion_ = ~0u;           // bonded_ version ljScale_ reflects
+    ThreadPool   pool_;
+    PotentialTable tables_;
+    PmeSolver    pme_;
+    BarnesHutSolver bh_;
+    int          bhEvalCount_ = 0;
+
+    Box box() const { return Box{worldSize, periodic}; }
+    /// `electrostatics`, except that PME falls back to Switched without
+    /// periodic: the Ewald sum's two halves must describe the same system.
+    Electrostatics electrostaticsInUse() const {
+        return (electrostatics == Electrostatics::PME && !periodic) ? Electrostatics::Switched
+                                                                     : electrostatics;
+    }
+    std::vector<char> present_;                   // species present, by type ID
+
+    // Pair kernel scratch
+    std::vector<float> charge_;                   // per atom
+    std::vector<float> ljScale_, pairForce_, pairEnergy_; // per neighbour pair
+    std::vector<std::vector<float>> forceBuf_;    // private xyz force buffers
+    std::vector<double> rangePE_;                 // potential energy per range
+    std::vector<float> angleBuf_;                 // angle kernel output, 7 arrays
+
+    /// Non-bonded group: LJ + Coulomb pairs, then PME or Barnes–Hut.
+    /// Returns its potential energy.
+    double computeNonbondedForces(AtomStore& atoms);
+
+    /// Pair forces for neighbour-list entries [begin, end), accumulated
+    /// into the given force arrays. Returns the pairs' potential energy.
+    double pairForceRange(const AtomStore& atoms, int begin, int end,
+                          float* fx, float* fy, float* fz);
+
     // ── Force models ──
     /// Morse potential force for bonded pairs: V = De*(1-exp(-α(r-re)))²
-    glm::vec3 morseForce(const Atom& a, const Atom& b, const Bond& bond,
-                         float dist, glm::vec3 dir) const;
+    /// (V is added to `energy`).
+    static glm::vec3 morseForce(const BondedPairs::Term& bond, float dist,
+                                glm::vec3 dir, float& energy);
 
-    /// Coulomb force between charged ions
-    glm::vec3 coulombForce(const Atom& a, const Atom& b,
-                           float dist, glm::vec3 dir) const;
+    /// Morse forces over the bond list. Returns the bonds' potential energy.
+    double applyBondForces(AtomStore& atoms) const;
 
-    /// Lennard-Jones 6-12 for non-bonded van der Waals
-    glm::vec3 ljForce(const Atom& a, const Atom& b,
-                      float dist, glm::vec3 dir) const;
+    /// VSEPR bond-angle forces over the angle terms in bonded_ (rebuilt
+    /// with the topology). Returns the angles' potential energy.
+    double applyAngleForces(AtomStore& atoms);
 
-    /// VSEPR bond-angle restoring force
-    void applyAngleForces(std::vector<Atom>& atoms);
+    // ── Emergent bonding decisions ──
+    /// Plan an ionic bond (Born-Haber energy check). On success `bond`
+    /// runs donor → acceptor as atomA → atomB. Changes nothing.
+    bool planIonicBond(const AtomStore& atoms, int idxA, int idxB, float dist, Bond& bond) const;
 
-    /// Smooth switching function for force cutoff
-    float switchingFunction(float dist) const;
+    /// Plan a covalent bond (overlap energy check). Changes nothing.
+    bool planCovalentBond(const AtomStore& atoms, int idxA, int idxB, float dist, Bond& bond) const;
 
-    // ── Emergent bonding decisions ──
-    /// Attempt ionic bonding (Born-Haber energy check)
-    bool tryIonicBond(Atom& a, Atom& b, int idxA, int idxB);
+    /// Plan the bond type the pair's electronegativity difference calls for.
+    bool planBond(const AtomStore& atoms, int i, int j, float dist, Bond& bond) const;
 
-    /// Attempt covalent bonding (overlap energy check)
-    bool tryCovalentBond(Atom& a, Atom& b, int idxA, int idxB);
+    /// Form a planned bond: electron transfer (ionic), the bond itself,
+    /// statistics and the reaction log.
+    void formBond(AtomStore& atoms, const Bond& bond);
 
     /// Compute estimated bond dissociation energy
     float estimateBondEnergy(const Atom& a, const Atom& b,
-                             Bond::Type type, int order) const;
-
-    /// Get VSEPR ideal bond angle from steric number
-    static float idealBondAngle(int stericNumber);
+                             Bond::Type type, int order, float dist) const;
 
     /// Should this bond break? (energy + thermal check)
     bool shouldBreakBond(const Atom& a, const Atom& b,
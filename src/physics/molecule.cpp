@@ -1,16 +1,18 @@
 #include "molecule.h"
-#include "atom.h"
+#include "atom_store.h"
 #include <queue>
 #include <algorithm>
 #include <map>
 
 namespace physics {
 
-void MoleculeTracker::update(const Atom* atoms, int atomCount) {
+void MoleculeTracker::update(const AtomStore& atoms, const Box& box) {
+    int atomCount = atoms.size();
     molecules_.clear();
     if (atomCount == 0) return;
 
     std::vector<bool> visited(atomCount, false);
+    unwrapped_.resize(atomCount);
     int molId = 0;
 
     for (int i = 0; i < atomCount; ++i) {
@@ -22,15 +24,18 @@ void MoleculeTracker::update(const Atom* atoms, int atomCount) {
         std::queue<int> q;
         q.push(i);
         visited[i] = true;
+        unwrapped_[i] = atoms.pos(i);
 
         while (!q.empty()) {
             int cur = q.front(); q.pop();
             mol.atomIndices.push_back(cur);
 
-            for (const auto& bond : atoms[cur].bonds) {
-                int other = bond.otherAtomIdx;
-                if (other >= 0 && other < atomCount && !visited[other]) {
+            for (const auto& edge : atoms.bonds().of(cur)) {
+                int other = edge.otherAtomIdx;
+                if (!visited[other]) {
                     visited[other] = true;
+                    // Walk bonds by nearest image so the molecule stays whole
+                    unwrapped_[other] = unwrapped_[cur] + box.delta(atoms.pos(other), atoms.pos(cur));
                     q.push(other);
                 }
             }
@@ -42,17 +47,22 @@ void MoleculeTracker::update(const Atom* atoms, int atomCount) {
         mol.totalBondEnergy = 0;
 
         for (int idx : mol.atomIndices) {
-            mol.totalMass += atoms[idx].mass;
-            mol.centerOfMass += atoms[idx].mass * atoms[idx].pos;
+            mol.totalMass += atoms.mass[idx];
+            mol.centerOfMass += atoms.mass[idx] * unwrapped_[idx];
         }
         if (mol.totalMass > 0)
             mol.centerOfMass /= mol.totalMass;
+        if (box.periodic) {
+            box.wrap(mol.centerOfMass.x);
+            box.wrap(mol.centerOfMass.y);
+            box.wrap(mol.centerOfMass.z);
+        }
 
         // Sum bond energies (only count each bond once)
         for (int idx : mol.atomIndices) {
-            for (const auto& bond : atoms[idx].bonds) {
-                if (bond.otherAtomIdx > idx)
-                    mol.totalBondEnergy += bond.strength;
+            for (const auto& edge : atoms.bonds().of(idx)) {
+                if (edge.otherAtomIdx > idx)
+                    mol.totalBondEnergy += atoms.bonds()[edge.bond].strength;
             }
         }
 
@@ -62,7 +72,12 @@ void MoleculeTracker::update(const Atom* atoms, int atomCount) {
     }
 }
 
-std::string MoleculeTracker::computeFormula(const Atom* atoms,
+void MoleculeTracker::remap(const std::vector<int>& newIndex) {
+    for (auto& mol : molecules_)
+        for (int& idx : mol.atomIndices) idx = newIndex[idx];
+}
+
+std::string MoleculeTracker::computeFormula(const AtomStore& atoms,
                                              const std::vector<int>& indices) {
     if (indices.size() == 1)
         return atoms[indices[0]].element->symbol;
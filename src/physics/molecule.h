@@ -1,4 +1,5 @@
 #pragma once
+#include "box.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
@@ -6,6 +7,8 @@
 
 namespace physics {
 
+class AtomStore;
+
 /// A molecule is a connected cluster of bonded atoms.
 struct Molecule {
     int id = -1;
@@ -19,17 +22,23 @@ struct Molecule {
 /// Manages molecule detection via bond-graph BFS.
 class MoleculeTracker {
 public:
-    /// Rebuild molecule list from current atom bond graph.
-    void update(const struct Atom* atoms, int atomCount);
+    /// Rebuild molecule list from current atom bond graph. In a periodic
+    /// box, molecules straddling a face are unwrapped before averaging.
+    void update(const AtomStore& atoms, const Box& box = Box{});
+
+    /// Rewrite atom indices after a pure reordering (old → new map);
+    /// removing atoms can split molecules, so that needs update().
+    void remap(const std::vector<int>& newIndex);
 
     const std::vector<Molecule>& molecules() const { return molecules_; }
     int count() const { return static_cast<int>(molecules_.size()); }
 
 private:
     std::vector<Molecule> molecules_;
+    std::vector<glm::vec3> unwrapped_;   // scratch: positions relative to each BFS seed
 
     /// Generate chemical formula from atom indices.
-    static std::string computeFormula(const struct Atom* atoms,
+    static std::string computeFormula(const AtomStore& atoms,
                                        const std::vector<int>& indices);
 };
 
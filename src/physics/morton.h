@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+namespace physics {
+
+/// Spread the low 10 bits of v so there are two zero bits between each.
+inline uint32_t spreadBits10(uint32_t v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8))  & 0x0300f00f;
+    v = (v | (v << 4))  & 0x030c30c3;
+    v = (v | (v << 2))  & 0x09249249;
+    return v;
+}
+
+/// 30-bit Morton (Z-order) code of 10-bit cell coordinates.
+inline uint32_t mortonCode(uint32_t x, uint32_t y, uint32_t z) {
+    return spreadBits10(x) | (spreadBits10(y) << 1) | (spreadBits10(z) << 2);
+}
+
+} // namespace physics
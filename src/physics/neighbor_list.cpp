@@ -0,0 +1,54 @@
+#include "neighbor_list.h"
+#include <algorithm>
+
+namespace physics {
+
+bool NeighborList::needsRebuild(const AtomStore& atoms, const Box& box,
+                                float cutoff, float skin) const {
+    int n = atoms.size();
+    if (!valid_ || static_cast<int>(refX_.size()) != n) return true;
+    if (cutoff != builtCutoff_ || skin != builtSkin_) return true;
+    if (box.halfWidth != builtBox_.halfWidth || box.periodic != builtBox_.periodic) return true;
+
+    // Two atoms each moving skin/2 toward each other is the worst case
+    float limit2 = 0.25f * skin * skin;
+    float maxDisp2 = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        float dx = box.minimumImage(atoms.x[i] - refX_[i]);   // wraps aren't moves
+        float dy = box.minimumImage(atoms.y[i] - refY_[i]);
+        float dz = box.minimumImage(atoms.z[i] - refZ_[i]);
+        maxDisp2 = std::max(maxDisp2, dx * dx + dy * dy + dz * dz);
+    }
+    return maxDisp2 > limit2;
+}
+
+bool NeighborList::update(const AtomStore& atoms, const Box& box,
+                          float cutoff, float skin) {
+    if (!needsRebuild(atoms, box, cutoff, skin)) return false;
+
+    float listRange = cutoff + skin;
+    float listRange2 = listRange * listRange;
+
+    pairI_.clear();
+    pairJ_.clear();
+    grid_.build(atoms, box, listRange);
+    grid_.forEachPair([&](int i, int j) {
+        float dx = box.minimumImage(atoms.x[i] - atoms.x[j]);
+        float dy = box.minimumImage(atoms.y[i] - atoms.y[j]);
+        float dz = box.minimumImage(atoms.z[i] - atoms.z[j]);
+        if (dx * dx + dy * dy + dz * dz > listRange2) return;
+        pairI_.push_back(std::min(i, j));
+        pairJ_.push_back(std::max(i, j));
+    });
+
+    refX_ = atoms.x;
+    refY_ = atoms.y;
+    refZ_ = atoms.z;
+    builtCutoff_ = cutoff;
+    builtSkin_ = skin;
+    builtBox_ = box;
+    valid_ = true;
+    return true;
+}
+
+} // namespace physics
@@ -0,0 +1,35 @@
+#pragma once
+#include "atom_store.h"
+#include "cell_grid.h"
+#include <vector>
+
+namespace physics {
+
+/// Verlet neighbour list: all pairs within cutoff + skin, kept across steps
+/// and rebuilt only once some atom has moved more than half the skin.
+class NeighborList {
+public:
+    /// Rebuild the list if it may have gone stale. Returns true if rebuilt.
+    bool update(const AtomStore& atoms, const Box& box,
+                float cutoff, float skin);
+
+    /// Force a rebuild on the next update (e.g. atoms added or reordered).
+    void invalidate() { valid_ = false; }
+
+    int pairCount() const { return static_cast<int>(pairI_.size()); }
+    const std::vector<int>& pairI() const { return pairI_; }
+    const std::vector<int>& pairJ() const { return pairJ_; }
+
+private:
+    bool valid_ = false;
+    float builtCutoff_ = 0, builtSkin_ = 0;
+    Box builtBox_;
+    CellGrid grid_;
+    std::vector<int> pairI_, pairJ_;
+    std::vector<float> refX_, refY_, refZ_;   // positions at last build
+
+    bool needsRebuild(const AtomStore& atoms, const Box& box,
+                      float cutoff, float skin) const;
+};
+
+} // namespace physics
@@ -0,0 +1,585 @@
+#include "pair_kernel.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PHYSICS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define PHYSICS_TARGET_AVX2
+#define PHYSICS_TARGET_AVX512
+#else
+#define PHYSICS_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define PHYSICS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+namespace physics {
+
+// ═══════════════════════════════════════════════════════════
+//  CPU feature detection
+// ═══════════════════════════════════════════════════════════
+#if defined(PHYSICS_X86) && defined(_MSC_VER) && !defined(__clang__)
+static SimdLevel queryCpu() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return SimdLevel::Scalar;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool fma     = (info[2] & (1 << 12)) != 0;
+    if (!osxsave) return SimdLevel::Scalar;
+    unsigned long long xcr0 = _xgetbv(0);
+    bool ymmOs = (xcr0 & 0x6) == 0x6;
+    bool zmmOs = (xcr0 & 0xe6) == 0xe6;
+    __cpuidex(info, 7, 0);
+    bool avx2    = (info[1] & (1 << 5)) != 0;
+    bool avx512f = (info[1] & (1 << 16)) != 0;
+    if (avx512f && zmmOs) return SimdLevel::AVX512;
+    if (avx2 && fma && ymmOs) return SimdLevel::AVX2;
+    return SimdLevel::Scalar;
+}
+#elif defined(PHYSICS_X86)
+static SimdLevel queryCpu() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::AVX2;
+    return SimdLevel::Scalar;
+}
+#else
+static SimdLevel queryCpu() { return SimdLevel::Scalar; }
+#endif
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = queryCpu();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2:   return "AVX2";
+        default:                return "scalar";
+    }
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Scalar reference kernel (also handles SIMD remainders)
+//  Lennard-Jones 6-12: V = 4ε[(σ/r)¹² - (σ/r)⁶]
+//  Coulomb:            F = k * q1 * q2 / r²
+//  Both use a 0.5 Å soft core and the cubic switch 1 - 3t² + 2t³
+//  between switchDist and cutoff.
+//  Ewald real space:   V = k * q1 * q2 * erfc(βr) / r, not switched
+// ═══════════════════════════════════════════════════════════
+static void pairForcesScalar(const PairKernelInput& in, int begin,
+                             float* fOverR, float* energy) {
+    float switchWidth = in.cutoff - in.switchDist;
+    bool ewald = in.ewaldBeta > 0.0f;
+    float beta = in.ewaldBeta;
+    float twoBetaOverSqrtPi = 2.0f * beta / std::sqrt(static_cast<float>(M_PI));
+    bool periodic = in.boxLength > 0.0f;
+    float L = in.boxLength, invL = periodic ? 1.0f / in.boxLength : 0.0f;
+    for (int p = begin; p < in.count; ++p) {
+        int i = in.pairI[p], j = in.pairJ[p];
+        float dx = in.x[i] - in.x[j];
+        float dy = in.y[i] - in.y[j];
+        float dz = in.z[i] - in.z[j];
+        if (periodic) {
+            dx -= L * std::floor(dx * invL + 0.5f);
+            dy -= L * std::floor(dy * invL + 0.5f);
+            dz -= L * std::floor(dz * invL + 0.5f);
+        }
+        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (dist < 0.01f || dist > in.cutoff) { fOverR[p] = energy[p] = 0.0f; continue; }
+
+        float sw = 1.0f;
+        if (dist > in.switchDist) {
+            float t = (dist - in.switchDist) / switchWidth;
+            sw = 1.0f - 3.0f * t * t + 2.0f * t * t * t;
+        }
+
+        float invSoft  = 1.0f / std::max(dist, 0.5f);
+        float invSoft2 = invSoft * invSoft;
+
+        float sr6 = in.sigma6[in.type[i] * in.typeCount + in.type[j]] *
+                    invSoft2 * invSoft2 * invSoft2;
+        float lj  = 24.0f * in.ljEpsilon * (2.0f * sr6 * sr6 - sr6) * invSoft;
+        float eLJ = 4.0f * in.ljEpsilon * (sr6 * sr6 - sr6);
+
+        float kqq   = in.coulK * in.charge[i] * in.charge[j];
+        float coul, eCoul;
+        if (ewald) {
+            float br = beta * std::max(dist, 0.5f);
+            float erfcBr = std::erfc(br);
+            eCoul = kqq * erfcBr * invSoft;
+            coul  = kqq * (erfcBr * invSoft + twoBetaOverSqrtPi * std::exp(-br * br)) * invSoft;
+        } else {
+            coul  = kqq * invSoft2 * sw;
+            eCoul = kqq * invSoft * sw;
+        }
+
+        fOverR[p] = (lj * in.ljScale[p] * sw + coul) / dist;
+        energy[p] = eLJ * in.ljScale[p] * sw + eCoul;
+    }
+}
+
+#if defined(PHYSICS_X86)
+// ═══════════════════════════════════════════════════════════
+//  Vector exp / erfc for the Ewald real-space term
+//  exp: Cephes expf range reduction + degree-5 polynomial (~1 ulp)
+//  erfc: Abramowitz & Stegun 7.1.26, |error| < 1.5e-7
+// ═══════════════════════════════════════════════════════════
+static constexpr float kExpP[6] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                                   4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+static constexpr float kErfcP = 0.3275911f;
+static constexpr float kErfcA[5] = {0.254829592f, -0.284496736f, 1.421413741f,
+                                    -1.453152027f, 1.061405429f};
+
+PHYSICS_TARGET_AVX2
+static inline __m256 expAVX2(__m256 x) {
+    x = _mm256_max_ps(x, _mm256_set1_ps(-87.0f));
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504f)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+    __m256 y = _mm256_set1_ps(kExpP[0]);
+    for (int k = 1; k < 6; ++k) y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(kExpP[k]));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+    __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+}
+
+/// erfc(x) for x ≥ 0, given exp(-x²)
+PHYSICS_TARGET_AVX2
+static inline __m256 erfcAVX2(__m256 x, __m256 expNegX2) {
+    __m256 t = _mm256_div_ps(_mm256_set1_ps(1.0f),
+                             _mm256_fmadd_ps(_mm256_set1_ps(kErfcP), x, _mm256_set1_ps(1.0f)));
+    __m256 y = _mm256_set1_ps(kErfcA[4]);
+    for (int k = 3; k >= 0; --k) y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(kErfcA[k]));
+    return _mm256_mul_ps(_mm256_mul_ps(y, t), expNegX2);
+}
+
+PHYSICS_TARGET_AVX512
+static inline __m512 expAVX512(__m512 x) {
+    x = _mm512_max_ps(x, _mm512_set1_ps(-87.0f));
+    __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(1.44269504f)),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(0.693359375f), x);
+    r = _mm512_fnmadd_ps(n, _mm512_set1_ps(-2.12194440e-4f), r);
+    __m512 y = _mm512_set1_ps(kExpP[0]);
+    for (int k = 1; k < 6; ++k) y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(kExpP[k]));
+    y = _mm512_fmadd_ps(y, _mm512_mul_ps(r, r), _mm512_add_ps(r, _mm512_set1_ps(1.0f)));
+    return _mm512_scalef_ps(y, n);
+}
+
+PHYSICS_TARGET_AVX512
+static inline __m512 erfcAVX512(__m512 x, __m512 expNegX2) {
+    __m512 t = _mm512_div_ps(_mm512_set1_ps(1.0f),
+                             _mm512_fmadd_ps(_mm512_set1_ps(kErfcP), x, _mm512_set1_ps(1.0f)));
+    __m512 y = _mm512_set1_ps(kErfcA[4]);
+    for (int k = 3; k >= 0; --k) y = _mm512_fmadd_ps(y, t, _mm512_set1_ps(kErfcA[k]));
+    return _mm512_mul_ps(_mm512_mul_ps(y, t), expNegX2);
+}
+
+/// d - L * round(d / L): nearest periodic image of a separation
+PHYSICS_TARGET_AVX2
+static inline __m256 minImageAVX2(__m256 d, __m256 boxL, __m256 invBoxL) {
+    __m256 shift = _mm256_round_ps(_mm256_mul_ps(d, invBoxL),
+                                   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return _mm256_fnmadd_ps(shift, boxL, d);
+}
+
+PHYSICS_TARGET_AVX512
+static inline __m512 minImageAVX512(__m512 d, __m512 boxL, __m512 invBoxL) {
+    __m512 shift = _mm512_roundscale_ps(_mm512_mul_ps(d, invBoxL),
+                                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return _mm512_fnmadd_ps(shift, boxL, d);
+}
+
+// ═══════════════════════════════════════════════════════════
+//  AVX2 + FMA: 8 pairs per iteration
+// ═══════════════════════════════════════════════════════════
+PHYSICS_TARGET_AVX2
+static void pairForcesAVX2(const PairKernelInput& in, float* fOverR, float* energy) {
+    const __m256 one      = _mm256_set1_ps(1.0f);
+    const __m256 two      = _mm256_set1_ps(2.0f);
+    const __m256 three    = _mm256_set1_ps(3.0f);
+    const __m256 minDist  = _mm256_set1_ps(0.01f);
+    const __m256 softCore = _mm256_set1_ps(0.5f);
+    const __m256 cutoff   = _mm256_set1_ps(in.cutoff);
+    const __m256 swStart  = _mm256_set1_ps(in.switchDist);
+    const __m256 invSwW   = _mm256_set1_ps(1.0f / (in.cutoff - in.switchDist));
+    const __m256 lj24     = _mm256_set1_ps(24.0f * in.ljEpsilon);
+    const __m256 lj4      = _mm256_set1_ps(4.0f * in.ljEpsilon);
+    const __m256 coulK    = _mm256_set1_ps(in.coulK);
+    const __m256i nTypes  = _mm256_set1_epi32(in.typeCount);
+    const bool   ewald    = in.ewaldBeta > 0.0f;
+    const __m256 beta     = _mm256_set1_ps(in.ewaldBeta);
+    const __m256 twoBetaOverSqrtPi = _mm256_set1_ps(2.0f * in.ewaldBeta / std::sqrt(static_cast<float>(M_PI)));
+    const bool   periodic = in.boxLength > 0.0f;
+    const __m256 boxL     = _mm256_set1_ps(in.boxLength);
+    const __m256 invBoxL  = _mm256_set1_ps(periodic ? 1.0f / in.boxLength : 0.0f);
+
+    int p = 0;
+    for (; p + 8 <= in.count; p += 8) {
+        __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.pairI + p));
+        __m256i vj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.pairJ + p));
+
+        __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(in.x, vi, 4), _mm256_i32gather_ps(in.x, vj, 4));
+        __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(in.y, vi, 4), _mm256_i32gather_ps(in.y, vj, 4));
+        __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(in.z, vi, 4), _mm256_i32gather_ps(in.z, vj, 4));
+        if (periodic) {
+            dx = minImageAVX2(dx, boxL, invBoxL);
+            dy = minImageAVX2(dy, boxL, invBoxL);
+            dz = minImageAVX2(dz, boxL, invBoxL);
+        }
+        __m256 r2 = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz)));
+        __m256 dist = _mm256_sqrt_ps(r2);
+
+        __m256 valid = _mm256_and_ps(_mm256_cmp_ps(dist, minDist, _CMP_GE_OQ),
+                                     _mm256_cmp_ps(dist, cutoff, _CMP_LE_OQ));
+        if (_mm256_movemask_ps(valid) == 0) {
+            _mm256_storeu_ps(fOverR + p, _mm256_setzero_ps());
+            _mm256_storeu_ps(energy + p, _mm256_setzero_ps());
+            continue;
+        }
+
+        // Switching function: 1 below switchDist, 1 - 3t² + 2t³ above
+        __m256 t  = _mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(dist, swStart), invSwW),
+                                  _mm256_setzero_ps());
+        __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 sw = _mm256_fmadd_ps(_mm256_mul_ps(two, t2), t,
+                                    _mm256_fnmadd_ps(three, t2, one));
+
+        __m256 invSoft  = _mm256_div_ps(one, _mm256_max_ps(dist, softCore));
+        __m256 invSoft2 = _mm256_mul_ps(invSoft, invSoft);
+
+        // Lennard-Jones, σ⁶ looked up by type pair
+        __m256i tp = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_i32gather_epi32(in.type, vi, 4), nTypes),
+                                      _mm256_i32gather_epi32(in.type, vj, 4));
+        __m256 inv6 = _mm256_mul_ps(_mm256_mul_ps(invSoft2, invSoft2), invSoft2);
+        __m256 sr6 = _mm256_mul_ps(_mm256_i32gather_ps(in.sigma6, tp, 4), inv6);
+        __m256 ljScale = _mm256_loadu_ps(in.ljScale + p);
+        __m256 lj  = _mm256_mul_ps(_mm256_mul_ps(lj24, _mm256_fmsub_ps(_mm256_mul_ps(two, sr6), sr6, sr6)),
+                                   _mm256_mul_ps(invSoft, ljScale));
+        __m256 eLJ = _mm256_mul_ps(_mm256_mul_ps(lj4, _mm256_fmsub_ps(sr6, sr6, sr6)), ljScale);
+
+        // Coulomb
+        __m256 qq   = _mm256_mul_ps(_mm256_i32gather_ps(in.charge, vi, 4),
+                                    _mm256_i32gather_ps(in.charge, vj, 4));
+        __m256 kqq  = _mm256_mul_ps(coulK, qq);
+        __m256 coul, eCoul;
+        if (ewald) {
+            __m256 br = _mm256_mul_ps(beta, _mm256_max_ps(dist, softCore));
+            __m256 ex = expAVX2(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(br, br)));
+            __m256 erfcBr = erfcAVX2(br, ex);
+            eCoul = _mm256_mul_ps(kqq, _mm256_mul_ps(erfcBr, invSoft));
+            coul  = _mm256_mul_ps(_mm256_mul_ps(kqq, invSoft),
+                                  _mm256_fmadd_ps(erfcBr, invSoft, _mm256_mul_ps(twoBetaOverSqrtPi, ex)));
+        } else {
+            coul  = _mm256_mul_ps(_mm256_mul_ps(kqq, invSoft2), sw);
+            eCoul = _mm256_mul_ps(_mm256_mul_ps(kqq, invSoft), sw);
+        }
+
+        __m256 f = _mm256_div_ps(_mm256_fmadd_ps(lj, sw, coul), dist);
+        __m256 e = _mm256_fmadd_ps(eLJ, sw, eCoul);
+        _mm256_storeu_ps(fOverR + p, _mm256_and_ps(f, valid));
+        _mm256_storeu_ps(energy + p, _mm256_and_ps(e, valid));
+    }
+    pairForcesScalar(in, p, fOverR, energy);
+}
+
+// ═══════════════════════════════════════════════════════════
+//  AVX-512F: 16 pairs per iteration
+// ═══════════════════════════════════════════════════════════
+PHYSICS_TARGET_AVX512
+static void pairForcesAVX512(const PairKernelInput& in, float* fOverR, float* energy) {
+    const __m512 one      = _mm512_set1_ps(1.0f);
+    const __m512 two      = _mm512_set1_ps(2.0f);
+    const __m512 three    = _mm512_set1_ps(3.0f);
+    const __m512 minDist  = _mm512_set1_ps(0.01f);
+    const __m512 softCore = _mm512_set1_ps(0.5f);
+    const __m512 cutoff   = _mm512_set1_ps(in.cutoff);
+    const __m512 swStart  = _mm512_set1_ps(in.switchDist);
+    const __m512 invSwW   = _mm512_set1_ps(1.0f / (in.cutoff - in.switchDist));
+    const __m512 lj24     = _mm512_set1_ps(24.0f * in.ljEpsilon);
+    const __m512 lj4      = _mm512_set1_ps(4.0f * in.ljEpsilon);
+    const __m512 coulK    = _mm512_set1_ps(in.coulK);
+    const __m512i nTypes  = _mm512_set1_epi32(in.typeCount);
+    const bool   ewald    = in.ewaldBeta > 0.0f;
+    const __m512 beta     = _mm512_set1_ps(in.ewaldBeta);
+    const __m512 twoBetaOverSqrtPi = _mm512_set1_ps(2.0f * in.ewaldBeta / std::sqrt(static_cast<float>(M_PI)));
+    const bool   periodic = in.boxLength > 0.0f;
+    const __m512 boxL     = _mm512_set1_ps(in.boxLength);
+    const __m512 invBoxL  = _mm512_set1_ps(periodic ? 1.0f / in.boxLength : 0.0f);
+
+    int p = 0;
+    for (; p + 16 <= in.count; p += 16) {
+        __m512i vi = _mm512_loadu_si512(in.pairI + p);
+        __m512i vj = _mm512_loadu_si512(in.pairJ + p);
+
+        __m512 dx = _mm512_sub_ps(_mm512_i32gather_ps(vi, in.x, 4), _mm512_i32gather_ps(vj, in.x, 4));
+        __m512 dy = _mm512_sub_ps(_mm512_i32gather_ps(vi, in.y, 4), _mm512_i32gather_ps(vj, in.y, 4));
+        __m512 dz = _mm512_sub_ps(_mm512_i32gather_ps(vi, in.z, 4), _mm512_i32gather_ps(vj, in.z, 4));
+        if (periodic) {
+            dx = minImageAVX512(dx, boxL, invBoxL);
+            dy = minImageAVX512(dy, boxL, invBoxL);
+            dz = minImageAVX512(dz, boxL, invBoxL);
+        }
+        __m512 r2 = _mm512_fmadd_ps(dx, dx, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dz, dz)));
+        __m512 dist = _mm512_sqrt_ps(r2);
+
+        __mmask16 valid = _mm512_cmp_ps_mask(dist, minDist, _CMP_GE_OQ) &
+                          _mm512_cmp_ps_mask(dist, cutoff, _CMP_LE_OQ);
+        if (valid == 0) {
+            _mm512_storeu_ps(fOverR + p, _mm512_setzero_ps());
+            _mm512_storeu_ps(energy + p, _mm512_setzero_ps());
+            continue;
+        }
+
+        __m512 t  = _mm512_max_ps(_mm512_mul_ps(_mm512_sub_ps(dist, swStart), invSwW),
+                                  _mm512_setzero_ps());
+        __m512 t2 = _mm512_mul_ps(t, t);
+        __m512 sw = _mm512_fmadd_ps(_mm512_mul_ps(two, t2), t,
+                                    _mm512_fnmadd_ps(three, t2, one));
+
+        __m512 invSoft  = _mm512_div_ps(one, _mm512_max_ps(dist, softCore));
+        __m512 invSoft2 = _mm512_mul_ps(invSoft, invSoft);
+
+        __m512i tp = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_i32gather_epi32(vi, in.type, 4), nTypes),
+                                      _mm512_i32gather_epi32(vj, in.type, 4));
+        __m512 inv6 = _mm512_mul_ps(_mm512_mul_ps(invSoft2, invSoft2), invSoft2);
+        __m512 sr6 = _mm512_mul_ps(_mm512_i32gather_ps(tp, in.sigma6, 4), inv6);
+        __m512 ljScale = _mm512_loadu_ps(in.ljScale + p);
+        __m512 lj  = _mm512_mul_ps(_mm512_mul_ps(lj24, _mm512_fmsub_ps(_mm512_mul_ps(two, sr6), sr6, sr6)),
+                                   _mm512_mul_ps(invSoft, ljScale));
+        __m512 eLJ = _mm512_mul_ps(_mm512_mul_ps(lj4, _mm512_fmsub_ps(sr6, sr6, sr6)), ljScale);
+
+        __m512 qq   = _mm512_mul_ps(_mm512_i32gather_ps(vi, in.charge, 4),
+                                    _mm512_i32gather_ps(vj, in.charge, 4));
+        __m512 kqq  = _mm512_mul_ps(coulK, qq);
+        __m512 coul, eCoul;
+        if (ewald) {
+            __m512 br = _mm512_mul_ps(beta, _mm512_max_ps(dist, softCore));
+            __m512 ex = expAVX512(_mm512_sub_ps(_mm512_setzero_ps(), _mm512_mul_ps(br, br)));
+            __m512 erfcBr = erfcAVX512(br, ex);
+            eCoul = _mm512_mul_ps(kqq, _mm512_mul_ps(erfcBr, invSoft));
+            coul  = _mm512_mul_ps(_mm512_mul_ps(kqq, invSoft),
+                                  _mm512_fmadd_ps(erfcBr, invSoft, _mm512_mul_ps(twoBetaOverSqrtPi, ex)));
+        } else {
+            coul  = _mm512_mul_ps(_mm512_mul_ps(kqq, invSoft2), sw);
+            eCoul = _mm512_mul_ps(_mm512_mul_ps(kqq, invSoft), sw);
+        }
+
+        __m512 f = _mm512_div_ps(_mm512_fmadd_ps(lj, sw, coul), dist);
+        __m512 e = _mm512_fmadd_ps(eLJ, sw, eCoul);
+        _mm512_storeu_ps(fOverR + p, _mm512_maskz_mov_ps(valid, f));
+        _mm512_storeu_ps(energy + p, _mm512_maskz_mov_ps(valid, e));
+    }
+    pairForcesScalar(in, p, fOverR, energy);
+}
+#endif
+
+// ═══════════════════════════════════════════════════════════
+//  Dispatch
+// ═══════════════════════════════════════════════════════════
+void nonbondedPairForces(SimdLevel level, const PairKernelInput& in,
+                         float* fOverR, float* energy) {
+    level = std::min(level, detectSimdLevel());
+#if defined(PHYSICS_X86)
+    if (level == SimdLevel::AVX512) { pairForcesAVX512(in, fOverR, energy); return; }
+    if (level == SimdLevel::AVX2)   { pairForcesAVX2(in, fOverR, energy);   return; }
+#endif
+    pairForcesScalar(in, 0, fOverR, energy);
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Bond-angle kernel
+//  Cosine-harmonic: V = ½k(cos θ − cos θ₀)², linear: V = k(1 + cos θ)
+//  F_a = −dV/dcos θ · (b̂ − cos θ â) / |a|, likewise for b
+// ═══════════════════════════════════════════════════════════
+static void angleForcesScalar(const AngleKernelInput& in, int begin,
+                              float* fax, float* fay, float* faz,
+                              float* fbx, float* fby, float* fbz, float* energy) {
+    bool periodic = in.boxLength > 0.0f;
+    float L = in.boxLength, invL = periodic ? 1.0f / in.boxLength : 0.0f;
+    auto image = [&](float d) { return periodic ? d - L * std::floor(d * invL + 0.5f) : d; };
+    for (int t = begin; t < in.count; ++t) {
+        int c = in.centre[t], a = in.a[t], b = in.b[t];
+        float ax = image(in.x[a] - in.x[c]), ay = image(in.y[a] - in.y[c]), az = image(in.z[a] - in.z[c]);
+        float bx = image(in.x[b] - in.x[c]), by = image(in.y[b] - in.y[c]), bz = image(in.z[b] - in.z[c]);
+        float la2 = ax * ax + ay * ay + az * az;
+        float lb2 = bx * bx + by * by + bz * bz;
+        if (la2 < 1e-4f || lb2 < 1e-4f) {
+            fax[t] = fay[t] = faz[t] = fbx[t] = fby[t] = fbz[t] = energy[t] = 0.0f;
+            continue;
+        }
+
+        float invA = 1.0f / std::sqrt(la2), invB = 1.0f / std::sqrt(lb2);
+        float cosT = std::clamp((ax * bx + ay * by + az * bz) * invA * invB, -1.0f, 1.0f);
+        float k = in.k[t], d = cosT - in.cos0[t];
+        bool linear = in.cos0[t] <= -1.0f;
+        float dVdc = linear ? k : k * d;
+        energy[t]  = linear ? k * (1.0f + cosT) : 0.5f * k * d * d;
+
+        float sA = -dVdc * invA, sB = -dVdc * invB;
+        fax[t] = sA * (bx * invB - cosT * ax * invA);
+        fay[t] = sA * (by * invB - cosT * ay * invA);
+        faz[t] = sA * (bz * invB - cosT * az * invA);
+        fbx[t] = sB * (ax * invA - cosT * bx * invB);
+        fby[t] = sB * (ay * invA - cosT * by * invB);
+        fbz[t] = sB * (az * invA - cosT * bz * invB);
+    }
+}
+
+#if defined(PHYSICS_X86)
+PHYSICS_TARGET_AVX2
+static void angleForcesAVX2(const AngleKernelInput& in,
+                            float* fax, float* fay, float* faz,
+                            float* fbx, float* fby, float* fbz, float* energy) {
+    const __m256 one      = _mm256_set1_ps(1.0f);
+    const __m256 negOne   = _mm256_set1_ps(-1.0f);
+    const __m256 half     = _mm256_set1_ps(0.5f);
+    const __m256 minLen2  = _mm256_set1_ps(1e-4f);
+    const bool   periodic = in.boxLength > 0.0f;
+    const __m256 boxL     = _mm256_set1_ps(in.boxLength);
+    const __m256 invBoxL  = _mm256_set1_ps(periodic ? 1.0f / in.boxLength : 0.0f);
+
+    int t = 0;
+    for (; t + 8 <= in.count; t += 8) {
+        __m256i vc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.centre + t));
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.a + t));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.b + t));
+        __m256 cx = _mm256_i32gather_ps(in.x, vc, 4);
+        __m256 cy = _mm256_i32gather_ps(in.y, vc, 4);
+        __m256 cz = _mm256_i32gather_ps(in.z, vc, 4);
+        __m256 ax = _mm256_sub_ps(_mm256_i32gather_ps(in.x, va, 4), cx);
+        __m256 ay = _mm256_sub_ps(_mm256_i32gather_ps(in.y, va, 4), cy);
+        __m256 az = _mm256_sub_ps(_mm256_i32gather_ps(in.z, va, 4), cz);
+        __m256 bx = _mm256_sub_ps(_mm256_i32gather_ps(in.x, vb, 4), cx);
+        __m256 by = _mm256_sub_ps(_mm256_i32gather_ps(in.y, vb, 4), cy);
+        __m256 bz = _mm256_sub_ps(_mm256_i32gather_ps(in.z, vb, 4), cz);
+        if (periodic) {
+            ax = minImageAVX2(ax, boxL, invBoxL); ay = minImageAVX2(ay, boxL, invBoxL);
+            az = minImageAVX2(az, boxL, invBoxL); bx = minImageAVX2(bx, boxL, invBoxL);
+            by = minImageAVX2(by, boxL, invBoxL); bz = minImageAVX2(bz, boxL, invBoxL);
+        }
+
+        __m256 la2 = _mm256_fmadd_ps(ax, ax, _mm256_fmadd_ps(ay, ay, _mm256_mul_ps(az, az)));
+        __m256 lb2 = _mm256_fmadd_ps(bx, bx, _mm256_fmadd_ps(by, by, _mm256_mul_ps(bz, bz)));
+        __m256 valid = _mm256_and_ps(_mm256_cmp_ps(la2, minLen2, _CMP_GE_OQ),
+                                     _mm256_cmp_ps(lb2, minLen2, _CMP_GE_OQ));
+        __m256 invA = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_max_ps(la2, minLen2)));
+        __m256 invB = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_max_ps(lb2, minLen2)));
+        __m256 dot  = _mm256_fmadd_ps(ax, bx, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(az, bz)));
+        __m256 cosT = _mm256_mul_ps(_mm256_mul_ps(dot, invA), invB);
+        cosT = _mm256_max_ps(_mm256_min_ps(cosT, one), negOne);
+
+        __m256 k      = _mm256_loadu_ps(in.k + t);
+        __m256 cos0   = _mm256_loadu_ps(in.cos0 + t);
+        __m256 linear = _mm256_cmp_ps(cos0, negOne, _CMP_LE_OQ);
+        __m256 d      = _mm256_sub_ps(cosT, cos0);
+        __m256 dVdc   = _mm256_blendv_ps(_mm256_mul_ps(k, d), k, linear);
+        __m256 e      = _mm256_blendv_ps(_mm256_mul_ps(_mm256_mul_ps(half, k), _mm256_mul_ps(d, d)),
+                                         _mm256_mul_ps(k, _mm256_add_ps(one, cosT)), linear);
+        dVdc = _mm256_and_ps(dVdc, valid);
+
+        // â, b̂ and the perpendicular components
+        __m256 uax = _mm256_mul_ps(ax, invA), uay = _mm256_mul_ps(ay, invA), uaz = _mm256_mul_ps(az, invA);
+        __m256 ubx = _mm256_mul_ps(bx, invB), uby = _mm256_mul_ps(by, invB), ubz = _mm256_mul_ps(bz, invB);
+        __m256 sA = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(dVdc, invA));
+        __m256 sB = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(dVdc, invB));
+        _mm256_storeu_ps(fax + t, _mm256_mul_ps(sA, _mm256_fnmadd_ps(cosT, uax, ubx)));
+        _mm256_storeu_ps(fay + t, _mm256_mul_ps(sA, _mm256_fnmadd_ps(cosT, uay, uby)));
+        _mm256_storeu_ps(faz + t, _mm256_mul_ps(sA, _mm256_fnmadd_ps(cosT, uaz, ubz)));
+        _mm256_storeu_ps(fbx + t, _mm256_mul_ps(sB, _mm256_fnmadd_ps(cosT, ubx, uax)));
+        _mm256_storeu_ps(fby + t, _mm256_mul_ps(sB, _mm256_fnmadd_ps(cosT, uby, uay)));
+        _mm256_storeu_ps(fbz + t, _mm256_mul_ps(sB, _mm256_fnmadd_ps(cosT, ubz, uaz)));
+        _mm256_storeu_ps(energy + t, _mm256_and_ps(e, valid));
+    }
+    angleForcesScalar(in, t, fax, fay, faz, fbx, fby, fbz, energy);
+}
+
+PHYSICS_TARGET_AVX512
+static void angleForcesAVX512(const AngleKernelInput& in,
+                              float* fax, float* fay, float* faz,
+                              float* fbx, float* fby, float* fbz, float* energy) {
+    const __m512 one      = _mm512_set1_ps(1.0f);
+    const __m512 negOne   = _mm512_set1_ps(-1.0f);
+    const __m512 half     = _mm512_set1_ps(0.5f);
+    const __m512 minLen2  = _mm512_set1_ps(1e-4f);
+    const bool   periodic = in.boxLength > 0.0f;
+    const __m512 boxL     = _mm512_set1_ps(in.boxLength);
+    const __m512 invBoxL  = _mm512_set1_ps(periodic ? 1.0f / in.boxLength : 0.0f);
+
+    int t = 0;
+    for (; t + 16 <= in.count; t += 16) {
+        __m512i vc = _mm512_loadu_si512(in.centre + t);
+        __m512i va = _mm512_loadu_si512(in.a + t);
+        __m512i vb = _mm512_loadu_si512(in.b + t);
+        __m512 cx = _mm512_i32gather_ps(vc, in.x, 4);
+        __m512 cy = _mm512_i32gather_ps(vc, in.y, 4);
+        __m512 cz = _mm512_i32gather_ps(vc, in.z, 4);
+        __m512 ax = _mm512_sub_ps(_mm512_i32gather_ps(va, in.x, 4), cx);
+        __m512 ay = _mm512_sub_ps(_mm512_i32gather_ps(va, in.y, 4), cy);
+        __m512 az = _mm512_sub_ps(_mm512_i32gather_ps(va, in.z, 4), cz);
+        __m512 bx = _mm512_sub_ps(_mm512_i32gather_ps(vb, in.x, 4), cx);
+        __m512 by = _mm512_sub_ps(_mm512_i32gather_ps(vb, in.y, 4), cy);
+        __m512 bz = _mm512_sub_ps(_mm512_i32gather_ps(vb, in.z, 4), cz);
+        if (periodic) {
+            ax = minImageAVX512(ax, boxL, invBoxL); ay = minImageAVX512(ay, boxL, invBoxL);
+            az = minImageAVX512(az, boxL, invBoxL); bx = minImageAVX512(bx, boxL, invBoxL);
+            by = minImageAVX512(by, boxL, invBoxL); bz = minImageAVX512(bz, boxL, invBoxL);
+        }
+
+        __m512 la2 = _mm512_fmadd_ps(ax, ax, _mm512_fmadd_ps(ay, ay, _mm512_mul_ps(az, az)));
+        __m512 lb2 = _mm512_fmadd_ps(bx, bx, _mm512_fmadd_ps(by, by, _mm512_mul_ps(bz, bz)));
+        __mmask16 valid = _mm512_cmp_ps_mask(la2, minLen2, _CMP_GE_OQ) &
+                          _mm512_cmp_ps_mask(lb2, minLen2, _CMP_GE_OQ);
+        __m512 invA = _mm512_div_ps(one, _mm512_sqrt_ps(_mm512_max_ps(la2, minLen2)));
+        __m512 invB = _mm512_div_ps(one, _mm512_sqrt_ps(_mm512_max_ps(lb2, minLen2)));
+        __m512 dot  = _mm512_fmadd_ps(ax, bx, _mm512_fmadd_ps(ay, by, _mm512_mul_ps(az, bz)));
+        __m512 cosT = _mm512_max_ps(_mm512_min_ps(_mm512_mul_ps(_mm512_mul_ps(dot, invA), invB), one), negOne);
+
+        __m512 k      = _mm512_loadu_ps(in.k + t);
+        __m512 cos0   = _mm512_loadu_ps(in.cos0 + t);
+        __mmask16 linear = _mm512_cmp_ps_mask(cos0, negOne, _CMP_LE_OQ);
+        __m512 d      = _mm512_sub_ps(cosT, cos0);
+        __m512 dVdc   = _mm512_mask_blend_ps(linear, _mm512_mul_ps(k, d), k);
+        __m512 e      = _mm512_mask_blend_ps(linear, _mm512_mul_ps(_mm512_mul_ps(half, k), _mm512_mul_ps(d, d)),
+                                             _mm512_mul_ps(k, _mm512_add_ps(one, cosT)));
+        dVdc = _mm512_maskz_mov_ps(valid, dVdc);
+
+        __m512 uax = _mm512_mul_ps(ax, invA), uay = _mm512_mul_ps(ay, invA), uaz = _mm512_mul_ps(az, invA);
+        __m512 ubx = _mm512_mul_ps(bx, invB), uby = _mm512_mul_ps(by, invB), ubz = _mm512_mul_ps(bz, invB);
+        __m512 sA = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_mul_ps(dVdc, invA));
+        __m512 sB = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_mul_ps(dVdc, invB));
+        _mm512_storeu_ps(fax + t, _mm512_mul_ps(sA, _mm512_fnmadd_ps(cosT, uax, ubx)));
+        _mm512_storeu_ps(fay + t, _mm512_mul_ps(sA, _mm512_fnmadd_ps(cosT, uay, uby)));
+        _mm512_storeu_ps(faz + t, _mm512_mul_ps(sA, _mm512_fnmadd_ps(cosT, uaz, ubz)));
+        _mm512_storeu_ps(fbx + t, _mm512_mul_ps(sB, _mm512_fnmadd_ps(cosT, ubx, uax)));
+        _mm512_storeu_ps(fby + t, _mm512_mul_ps(sB, _mm512_fnmadd_ps(cosT, uby, uay)));
+        _mm512_storeu_ps(fbz + t, _mm512_mul_ps(sB, _mm512_fnmadd_ps(cosT, ubz, uaz)));
+        _mm512_storeu_ps(energy + t, _mm512_maskz_mov_ps(valid, e));
+    }
+    angleForcesScalar(in, t, fax, fay, faz, fbx, fby, fbz, energy);
+}
+#endif
+
+void angleForces(SimdLevel level, const AngleKernelInput& in,
+                 float* fax, float* fay, float* faz,
+                 float* fbx, float* fby, float* fbz, float* energy) {
+    level = std::min(level, detectSimdLevel());
+#if defined(PHYSICS_X86)
+    if (level == SimdLevel::AVX512) { angleForcesAVX512(in, fax, fay, faz, fbx, fby, fbz, energy); return; }
+    if (level == SimdLevel::AVX2)   { angleForcesAVX2(in, fax, fay, faz, fbx, fby, fbz, energy);   return; }
+#endif
+    angleForcesScalar(in, 0, fax, fay, faz, fbx, fby, fbz, energy);
+}
+
+} // namespace physics
@@ -0,0 +1,69 @@
+#pragma once
+
+namespace physics {
+
+/// Instruction-set tiers for the non-bonded pair kernel.
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+/// Best tier supported by this CPU (queried once via CPUID).
+SimdLevel detectSimdLevel();
+
+const char* simdLevelName(SimdLevel level);
+
+/// Inputs for the non-bonded kernel. Arrays are indexed by atom (x..type),
+/// by pair (pairI, pairJ, ljScale) or by type pair (sigma6).
+struct PairKernelInput {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    const float* charge  = nullptr;   // e
+    const int*   type    = nullptr;   // pair-table type ID
+    const float* sigma6  = nullptr;   // σ⁶ in Å⁶, [typeI * typeCount + typeJ]
+    int   typeCount = 0;
+    const int*   pairI   = nullptr;
+    const int*   pairJ   = nullptr;
+    const float* ljScale = nullptr;   // 1 = apply LJ, 0 = bonded (Morse instead)
+    int   count = 0;
+
+    float ljEpsilon  = 0;             // eV
+    float coulK      = 0;             // eV·Å/e²
+    float cutoff     = 0;             // Å
+    float switchDist = 0;             // Å
+    float ewaldBeta  = 0;             // 1/Å — if > 0, Coulomb is the Ewald
+                                      // real-space term (erfc-screened, unswitched)
+    float boxLength  = 0;             // Å — if > 0, periodic: minimum-image separations
+};
+
+/// Evaluate LJ + Coulomb, both scaled by the cubic switching function (or
+/// LJ switched + Ewald real-space Coulomb when ewaldBeta > 0), for every
+/// pair. Writes |F|/r per pair into fOverR, so the force on atom i is
+/// fOverR * (pos_i - pos_j), and the switched pair energy (eV) into energy.
+/// Pairs closer than 0.01 Å or beyond the cutoff get 0. `level` is clamped
+/// to what the CPU supports.
+void nonbondedPairForces(SimdLevel level, const PairKernelInput& in,
+                         float* fOverR, float* energy);
+
+/// Inputs for the bond-angle kernel: atom positions plus one a–centre–b
+/// triplet per term.
+struct AngleKernelInput {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    const int*   centre = nullptr;
+    const int*   a      = nullptr;
+    const int*   b      = nullptr;
+    const float* cos0   = nullptr;    // cos θ₀; −1 marks a linear centre
+    const float* k      = nullptr;    // eV
+    int   count = 0;
+    float boxLength = 0;              // Å — if > 0, periodic: minimum-image separations
+};
+
+/// Cosine-harmonic angle terms, E = ½k(cos θ − cos θ₀)², or k(1 + cos θ)
+/// for linear centres, with no acos. Writes the force on the outer atoms a
+/// and b per term (the centre takes −(fa + fb)) and the energy. Terms with
+/// an arm shorter than 0.01 Å get 0.
+void angleForces(SimdLevel level, const AngleKernelInput& in,
+                 float* fax, float* fay, float* faz,
+                 float* fbx, float* fby, float* fbz, float* energy);
+
+} // namespace physics
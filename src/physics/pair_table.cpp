@@ -0,0 +1,49 @@
+#include "pair_table.h"
+#include "element.h"
+#include <algorithm>
+#include <cmath>
+
+namespace physics {
+
+PairTable& PairTable::instance() {
+    static PairTable table;
+    return table;
+}
+
+void PairTable::build(const PeriodicTable& table) {
+    int maxZ = 0;
+    for (const auto& [z, e] : table.all()) maxZ = std::max(maxZ, z);
+    typeCount_ = maxZ + 1;
+    params_.assign(typeCount_ * typeCount_, PairParams{});
+    sigma6_.assign(typeCount_ * typeCount_, 0.0f);
+
+    for (int za = 0; za < typeCount_; ++za) {
+        const ElementData& a = table.get(za);
+        for (int zb = 0; zb < typeCount_; ++zb) {
+            const ElementData& b = table.get(zb);
+            PairParams& p = params_[za * typeCount_ + zb];
+
+            p.sigma = (a.vdwRadius + b.vdwRadius) / 200.0f; // pm→Å
+            float s3 = p.sigma * p.sigma * p.sigma;
+            p.sigma6 = s3 * s3;
+
+            p.covalentRe = (a.covalentRadius + b.covalentRadius) / 100.0f;
+
+            // Covalent: geometric mean of electron affinities plus a share
+            // of the geometric mean of ionization energies
+            float eaA = std::max(a.electronAffinity, 0.1f);
+            float eaB = std::max(b.electronAffinity, 0.1f);
+            p.covalentE = std::sqrt(eaA * eaB) +
+                          std::sqrt(a.ionizationEnergy * b.ionizationEnergy) * 0.1f;
+
+            // Ionic: donor is the less electronegative partner
+            const ElementData& donor    = (a.electronegativity < b.electronegativity) ? a : b;
+            const ElementData& acceptor = (&donor == &a) ? b : a;
+            p.ionicDeltaE = donor.ionizationEnergy - acceptor.electronAffinity;
+
+            sigma6_[za * typeCount_ + zb] = p.sigma6;
+        }
+    }
+}
+
+} // namespace physics
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+namespace physics {
+
+class PeriodicTable;
+
+/// Interaction parameters for one element pair that depend only on the two
+/// atomic numbers.
+struct PairParams {
+    float sigma        = 0;   // Å — LJ σ from vdW radii
+    float sigma6       = 0;   // Å⁶
+    float covalentRe   = 0;   // Å — covalent equilibrium distance
+    float covalentE    = 0;   // eV — single-bond energy before overlap factor
+    float ionicDeltaE  = 0;   // eV — IE(donor) - EA(acceptor), donor = lower χ
+};
+
+/// Dense Z×Z parameter matrix, built once after the periodic table loads.
+/// Type IDs are atomic numbers, so lookups need no Atom::element hop.
+class PairTable {
+public:
+    static PairTable& instance();
+
+    /// Precompute all pair parameters from the loaded elements.
+    void build(const PeriodicTable& table);
+
+    int typeCount() const { return typeCount_; }
+    const PairParams& get(int zA, int zB) const { return params_[zA * typeCount_ + zB]; }
+
+    /// σ⁶ as a flat typeCount² array for the vectorised pair kernel.
+    const float* sigma6() const { return sigma6_.data(); }
+
+private:
+    PairTable() = default;
+    int typeCount_ = 0;
+    std::vector<PairParams> params_;
+    std::vector<float> sigma6_;
+};
+
+} // namespace physics
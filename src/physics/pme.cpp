@@ -0,0 +1,223 @@
+#include "pme.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace physics {
+
+static constexpr int kMaxOrder = 8;
+
+float PmeSolver::ewaldBeta(float cutoff, float tolerance) {
+    // erfc(β·rc) is monotone in β: bracket, then bisect
+    double hi = 1.0;
+    while (std::erfc(hi * cutoff) > tolerance) hi *= 2.0;
+    double lo = 0.0;
+    for (int it = 0; it < 60; ++it) {
+        double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid * cutoff) > tolerance) lo = mid; else hi = mid;
+    }
+    return static_cast<float>(hi);
+}
+
+// Cardinal B-spline weights M_n(w + k) for the `order` mesh points starting
+// at floor(u), and their derivatives with respect to u
+void PmeSolver::bspline(float w, int order, float* theta, float* dtheta) {
+    theta[order - 1] = 0.0f;
+    theta[1] = w;
+    theta[0] = 1.0f - w;
+    for (int j = 3; j < order; ++j) {
+        float div = 1.0f / (j - 1);
+        theta[j - 1] = div * w * theta[j - 2];
+        for (int k = 1; k < j - 1; ++k)
+            theta[j - k - 1] = div * ((w + k) * theta[j - k - 2] + (j - k - w) * theta[j - k - 1]);
+        theta[0] = div * (1.0f - w) * theta[0];
+    }
+
+    dtheta[0] = -theta[0];
+    for (int j = 1; j < order; ++j) dtheta[j] = theta[j - 1] - theta[j];
+
+    float div = 1.0f / (order - 1);
+    theta[order - 1] = div * w * theta[order - 2];
+    for (int k = 1; k < order - 1; ++k)
+        theta[order - k - 1] = div * ((w + k) * theta[order - k - 2] + (order - k - w) * theta[order - k - 1]);
+    theta[0] = div * (1.0f - w) * theta[0];
+}
+
+void PmeSolver::setup(float halfWidth, float coulK, const Settings& settings) {
+    float boxLength = 2.0f * halfWidth;
+    if (mesh_ > 0 && settings == settings_ && boxLength == boxLength_ && coulK == coulK_)
+        return;
+
+    settings_ = settings;
+    settings_.order = std::clamp(settings.order, 3, kMaxOrder);
+    boxLength_ = boxLength;
+    coulK_ = coulK;
+    beta_ = ewaldBeta(settings.cutoff, settings.tolerance);
+
+    int order = settings_.order;
+    int wanted = static_cast<int>(std::ceil(boxLength / std::max(settings.spacing, 0.1f)));
+    mesh_ = Fft3d::goodSize(std::max(wanted, 2 * order));
+    int K = mesh_;
+    fft_.resize(K, K, K);
+
+    // |b(m)|⁻² spline moduli, the same on every axis of a cubic mesh
+    float theta[kMaxOrder], dtheta[kMaxOrder];
+    bspline(0.0f, order, theta, dtheta);
+    std::vector<double> moduli(K);
+    for (int m = 0; m < K; ++m) {
+        double sc = 0.0, ss = 0.0;
+        for (int k = 0; k < order; ++k) {
+            double arg = 2.0 * M_PI * m * k / K;
+            sc += theta[k] * std::cos(arg);
+            ss += theta[k] * std::sin(arg);
+        }
+        moduli[m] = sc * sc + ss * ss;
+    }
+    for (int m = 0; m < K; ++m)   // odd orders vanish at the Nyquist point
+        if (moduli[m] < 1e-7) moduli[m] = 0.5 * (moduli[(m + K - 1) % K] + moduli[(m + 1) % K]);
+
+    // Influence function: k exp(-π²m²/β²) / (π V m² |b(m)|²)
+    double volume = static_cast<double>(boxLength) * boxLength * boxLength;
+    double piOverBeta2 = M_PI * M_PI / (static_cast<double>(beta_) * beta_);
+    influence_.assign(static_cast<size_t>(K) * K * K, 0.0f);
+    for (int kx = 0; kx < K; ++kx) {
+        double mx = (kx <= K / 2 ? kx : kx - K) / static_cast<double>(boxLength);
+        for (int ky = 0; ky < K; ++ky) {
+            double my = (ky <= K / 2 ? ky : ky - K) / static_cast<double>(boxLength);
+            for (int kz = 0; kz < K; ++kz) {
+                double mz = (kz <= K / 2 ? kz : kz - K) / static_cast<double>(boxLength);
+                double m2 = mx * mx + my * my + mz * mz;
+                double damping = std::exp(-piOverBeta2 * m2);
+                if (m2 == 0.0 || damping < 1e-20) continue;   // keep the mesh free of denormals
+                double g = coulK * damping /
+                           (M_PI * volume * m2 * moduli[kx] * moduli[ky] * moduli[kz]);
+                influence_[(static_cast<size_t>(kx) * K + ky) * K + kz] = static_cast<float>(g);
+            }
+        }
+    }
+}
+
+double PmeSolver::compute(AtomStore& atoms, const std::vector<float>& charge,
+                          float halfWidth, float coulK, const Settings& settings,
+                          ThreadPool& pool) {
+    setup(halfWidth, coulK, settings);
+
+    charged_.clear();
+    double qSum = 0.0, q2Sum = 0.0;
+    for (int i = 0; i < atoms.size(); ++i) {
+        if (charge[i] == 0.0f) continue;
+        charged_.push_back(i);
+        qSum += charge[i];
+        q2Sum += static_cast<double>(charge[i]) * charge[i];
+    }
+    if (charged_.empty()) return 0.0;
+
+    const int K = mesh_;
+    const int order = settings_.order;
+    const int nq = static_cast<int>(charged_.size());
+    const float toMesh = K / boxLength_;
+
+    // ── Spline weights per charged atom ──
+    base_.resize(3 * nq);
+    theta_.resize(3 * nq * order);
+    dtheta_.resize(3 * nq * order);
+    for (int c = 0; c < nq; ++c) {
+        int i = charged_[c];
+        const float pos[3] = {atoms.x[i], atoms.y[i], atoms.z[i]};
+        for (int d = 0; d < 3; ++d) {
+            float u = (pos[d] + halfWidth) * toMesh;
+            u -= std::floor(u / K) * K;          // periodic wrap into [0, K)
+            int b = std::min(static_cast<int>(u), K - 1);
+            base_[3 * c + d] = b;
+            bspline(u - b, order, &theta_[(3 * c + d) * order], &dtheta_[(3 * c + d) * order]);
+        }
+    }
+
+    // ── Spread charges onto the mesh ──
+    auto& grid = fft_.data();
+    std::fill(grid.begin(), grid.end(), Fft3d::Complex(0.0f, 0.0f));
+    for (int c = 0; c < nq; ++c) {
+        float q = charge[charged_[c]];
+        const float* tx = &theta_[(3 * c + 0) * order];
+        const float* ty = &theta_[(3 * c + 1) * order];
+        const float* tz = &theta_[(3 * c + 2) * order];
+        for (int ix = 0; ix < order; ++ix) {
+            int gx = (base_[3 * c] + ix) % K;
+            for (int iy = 0; iy < order; ++iy) {
+                int gy = (base_[3 * c + 1] + iy) % K;
+                float qxy = q * tx[ix] * ty[iy];
+                size_t row = (static_cast<size_t>(gx) * K + gy) * K;
+                for (int iz = 0; iz < order; ++iz) {
+                    int gz = (base_[3 * c + 2] + iz) % K;
+                    grid[row + gz] += Fft3d::Complex(qxy * tz[iz], 0.0f);
+                }
+            }
+        }
+    }
+
+    // ── Convolve with the reciprocal kernel ──
+    fft_.forward(pool);
+    std::vector<double> slabEnergy(K, 0.0);
+    pool.run(K, [&](int kx, int) {
+        size_t begin = static_cast<size_t>(kx) * K * K, end = begin + static_cast<size_t>(K) * K;
+        double e = 0.0;
+        for (size_t m = begin; m < end; ++m) {
+            float g = influence_[m];
+            float re = grid[m].real(), im = grid[m].imag();
+            e += g * (re * re + im * im);
+            grid[m] = Fft3d::Complex(g * re, g * im);
+        }
+        slabEnergy[kx] = e;
+    });
+    fft_.inverse(pool);
+
+    double energy = 0.0;
+    for (double e : slabEnergy) energy += e;
+    energy *= 0.5;
+
+    // ── Gather forces: F = -q Σ ∇θ · φ ──
+    int tasks = std::min(nq, 4 * pool.size());
+    pool.run(tasks, [&](int task, int) {
+        int begin = nq * task / tasks, end = nq * (task + 1) / tasks;
+        for (int c = begin; c < end; ++c) {
+            const float* tx = &theta_[(3 * c + 0) * order];
+            const float* ty = &theta_[(3 * c + 1) * order];
+            const float* tz = &theta_[(3 * c + 2) * order];
+            const float* dx = &dtheta_[(3 * c + 0) * order];
+            const float* dy = &dtheta_[(3 * c + 1) * order];
+            const float* dz = &dtheta_[(3 * c + 2) * order];
+            float gx = 0.0f, gy = 0.0f, gz = 0.0f;
+            for (int ix = 0; ix < order; ++ix) {
+                int mx = (base_[3 * c] + ix) % K;
+                for (int iy = 0; iy < order; ++iy) {
+                    int my = (base_[3 * c + 1] + iy) % K;
+                    size_t row = (static_cast<size_t>(mx) * K + my) * K;
+                    for (int iz = 0; iz < order; ++iz) {
+                        int mz = (base_[3 * c + 2] + iz) % K;
+                        float phi = grid[row + mz].real();
+                        gx += dx[ix] * ty[iy] * tz[iz] * phi;
+                        gy += tx[ix] * dy[iy] * tz[iz] * phi;
+                        gz += tx[ix] * ty[iy] * dz[iz] * phi;
+                    }
+                }
+            }
+            int i = charged_[c];
+            float s = -charge[i] * toMesh;
+            atoms.fx[i] += s * gx;
+            atoms.fy[i] += s * gy;
+            atoms.fz[i] += s * gz;
+        }
+    });
+
+    // Self-interaction of each Gaussian, and the uniform background that
+    // neutralises a net charge
+    double volume = static_cast<double>(boxLength_) * boxLength_ * boxLength_;
+    energy -= coulK * beta_ / std::sqrt(M_PI) * q2Sum;
+    energy -= coulK * M_PI * qSum * qSum / (2.0 * volume * beta_ * beta_);
+    return energy;
+}
+
+} // namespace physics
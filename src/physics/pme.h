@@ -0,0 +1,61 @@
+#pragma once
+#include "atom_store.h"
+#include "fft.h"
+#include "thread_pool.h"
+#include <vector>
+
+namespace physics {
+
+/// Smooth particle-mesh Ewald reciprocal-space sum (Essmann et al. 1995).
+///
+/// Treats the cubic box [-halfWidth, halfWidth)³ as the periodic cell.
+/// Charges are spread onto a mesh with B-splines, the mesh is convolved
+/// with the Ewald reciprocal kernel through an FFT, and forces are gathered
+/// back with the spline derivatives. The real-space erfc part is evaluated
+/// by the pair kernel with the same β.
+class PmeSolver {
+public:
+    struct Settings {
+        float cutoff    = 10.0f;   // Å — real-space cutoff β is chosen for
+        float tolerance = 1e-5f;   // erfc(β·cutoff)
+        float spacing   = 1.0f;    // Å — upper bound on mesh spacing
+        int   order     = 4;       // B-spline order (4 = cubic)
+        bool operator==(const Settings& o) const {
+            return cutoff == o.cutoff && tolerance == o.tolerance &&
+                   spacing == o.spacing && order == o.order;
+        }
+    };
+
+    /// Ewald splitting parameter β (1/Å) for the given cutoff and tolerance.
+    static float ewaldBeta(float cutoff, float tolerance);
+
+    /// Reciprocal-space forces (added to the store), plus the self and
+    /// neutralising-background corrections. Returns that energy in eV.
+    double compute(AtomStore& atoms, const std::vector<float>& charge,
+                   float halfWidth, float coulK, const Settings& settings,
+                   ThreadPool& pool);
+
+    float beta() const { return beta_; }
+    int meshSize() const { return mesh_; }
+
+private:
+    Settings settings_;
+    float boxLength_ = 0;
+    float coulK_ = 0;
+    float beta_ = 0;
+    int mesh_ = 0;                     // mesh points per axis
+
+    Fft3d fft_;
+    std::vector<float> influence_;     // reciprocal kernel per mesh point, 0 at m = 0
+
+    // Per charged atom: atom index, first mesh index per axis, spline
+    // weights and derivatives (order values per axis)
+    std::vector<int> charged_;
+    std::vector<int> base_;
+    std::vector<float> theta_, dtheta_;
+
+    void setup(float halfWidth, float coulK, const Settings& settings);
+    static void bspline(float w, int order, float* theta, float* dtheta);
+};
+
+} // namespace physics
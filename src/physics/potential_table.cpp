@@ -0,0 +1,170 @@
+#include "potential_table.h"
+#include "pair_table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace physics {
+
+static constexpr float kSoftCore = 0.5f;   // Å — same soft core as the analytic kernel
+static constexpr float kRelErrorFloor = 1e-3f; // eV/Å — ignore near-zero forces (LJ minimum, switch tail)
+
+static uint32_t floatBits(float f) { uint32_t u; std::memcpy(&u, &f, sizeof u); return u; }
+static float bitsFloat(uint32_t u) { float f; std::memcpy(&f, &u, sizeof f); return f; }
+
+// Switched LJ (or Coulomb per unit charge product) at r² = x, exactly as
+// the analytic pair kernel computes it.
+static void analytic(float x, float sigma6, bool coulomb,
+                     const PotentialTable::Settings& s, float& fOverR, float& energy) {
+    float r = std::sqrt(x);
+    if (r > s.cutoff) { fOverR = energy = 0.0f; return; }
+
+    float sw = 1.0f;
+    if (r > s.switchDist) {
+        float t = (r - s.switchDist) / (s.cutoff - s.switchDist);
+        sw = 1.0f - 3.0f * t * t + 2.0f * t * t * t;
+    }
+
+    float invSoft  = 1.0f / std::max(r, kSoftCore);
+    float invSoft2 = invSoft * invSoft;
+    float mag, e;
+    if (coulomb && s.ewaldBeta > 0.0f) {
+        // Ewald real space is short-ranged by construction: no switch
+        float br = s.ewaldBeta / invSoft;
+        float erfcBr = std::erfc(br);
+        fOverR = s.coulK * (erfcBr * invSoft + 2.0f * s.ewaldBeta / std::sqrt(static_cast<float>(M_PI)) *
+                 std::exp(-br * br)) * invSoft / r;
+        energy = s.coulK * erfcBr * invSoft;
+        return;
+    }
+    if (coulomb) {
+        mag = s.coulK * invSoft2;
+        e   = s.coulK * invSoft;
+    } else {
+        float sr6 = sigma6 * invSoft2 * invSoft2 * invSoft2;
+        mag = 24.0f * s.ljEpsilon * (2.0f * sr6 * sr6 - sr6) * invSoft;
+        e   = 4.0f * s.ljEpsilon * (sr6 * sr6 - sr6);
+    }
+    fOverR = mag * sw / r;
+    energy = e * sw;
+}
+
+void PotentialTable::fill(float* out, float sigma6, bool coulomb) {
+    for (int k = 0; k < nodeCount_; ++k) {
+        float x = bitsFloat((keyMin_ + k) << shift_);
+        analytic(x, sigma6, coulomb, settings_, out[4 * k], out[4 * k + 2]);
+    }
+    for (int k = 0; k < nodeCount_; ++k) {
+        bool last = (k + 1 == nodeCount_);
+        out[4 * k + 1] = last ? 0.0f : out[4 * (k + 1)]     - out[4 * k];
+        out[4 * k + 3] = last ? 0.0f : out[4 * (k + 1) + 2] - out[4 * k + 2];
+    }
+
+    // Accuracy against the analytic form at interval midpoints
+    uint32_t half = 1u << (shift_ - 1);
+    for (int k = 0; k + 1 < nodeCount_; ++k) {
+        float x = bitsFloat(((keyMin_ + k) << shift_) | half);
+        if (x > cutoff2_) break;
+        float fExact, eExact;
+        analytic(x, sigma6, coulomb, settings_, fExact, eExact);
+        float fTab = out[4 * k] + 0.5f * out[4 * k + 1];
+        float r = std::sqrt(x);
+        float absErr = std::abs(fTab - fExact) * r;
+        float mag = std::abs(fExact) * r;
+        maxAbsError_ = std::max(maxAbsError_, absErr);
+        if (mag > kRelErrorFloor) maxRelError_ = std::max(maxRelError_, absErr / mag);
+    }
+}
+
+bool PotentialTable::update(const std::vector<char>& present, const Settings& settings) {
+    const PairTable& params = PairTable::instance();
+    if (data_ && settings == settings_ && present == builtFor_ &&
+        typeCount_ == params.typeCount())
+        return false;
+
+    settings_ = settings;
+    builtFor_ = present;
+    typeCount_ = params.typeCount();
+
+    // Node layout shared by all tables: r² from the soft core to the cutoff
+    shift_ = 23 - std::clamp(settings.tableBits, 1, 16);
+    fracScale_ = 1.0f / static_cast<float>(1u << shift_);
+    rMin2_ = kSoftCore * kSoftCore;
+    cutoff2_ = settings.cutoff * settings.cutoff;
+    keyMin_ = floatBits(rMin2_) >> shift_;
+    uint32_t keyMax = floatBits(std::max(cutoff2_, rMin2_)) >> shift_;
+    nodeCount_ = static_cast<int>(keyMax - keyMin_) + 2;
+
+    // Table 0 is Coulomb; one LJ table per unordered pair of present types
+    slot_.assign(typeCount_ * typeCount_, -1);
+    int tables = 1;
+    for (int a = 0; a < typeCount_; ++a) {
+        if (a >= static_cast<int>(present.size()) || !present[a]) continue;
+        for (int b = a; b < typeCount_; ++b) {
+            if (b >= static_cast<int>(present.size()) || !present[b]) continue;
+            slot_[a * typeCount_ + b] = slot_[b * typeCount_ + a] = tables++;
+        }
+    }
+
+    floatCount_ = static_cast<size_t>(tables) * nodeCount_ * 4;
+    data_.reset(static_cast<float*>(::operator new[](floatCount_ * sizeof(float),
+                                                     std::align_val_t(64))));
+
+    maxAbsError_ = maxRelError_ = 0.0f;
+    fill(data_.get(), 0.0f, true);
+    for (int a = 0; a < typeCount_; ++a) {
+        for (int b = a; b < typeCount_; ++b) {
+            int t = slot_[a * typeCount_ + b];
+            if (t < 0) continue;
+            fill(data_.get() + static_cast<size_t>(t) * nodeCount_ * 4,
+                 params.get(a, b).sigma6, false);
+        }
+    }
+    return true;
+}
+
+void PotentialTable::pairForces(const PairKernelInput& in, float* fOverR, float* energy) const {
+    const float* coul = table(0);
+    uint32_t fracMask = (1u << shift_) - 1;
+    bool periodic = in.boxLength > 0.0f;
+    float L = in.boxLength, invL = periodic ? 1.0f / in.boxLength : 0.0f;
+
+    for (int p = 0; p < in.count; ++p) {
+        int i = in.pairI[p], j = in.pairJ[p];
+        float dx = in.x[i] - in.x[j];
+        float dy = in.y[i] - in.y[j];
+        float dz = in.z[i] - in.z[j];
+        if (periodic) {
+            dx -= L * std::floor(dx * invL + 0.5f);
+            dy -= L * std::floor(dy * invL + 0.5f);
+            dz -= L * std::floor(dz * invL + 0.5f);
+        }
+        float r2 = dx * dx + dy * dy + dz * dz;
+        if (r2 < 1e-4f || r2 > cutoff2_) { fOverR[p] = energy[p] = 0.0f; continue; }
+
+        const float* lj = table(slot_[in.type[i] * typeCount_ + in.type[j]]);
+        float ljScale = in.ljScale[p];
+        float qq = in.charge[i] * in.charge[j];
+
+        if (r2 >= rMin2_) {
+            uint32_t bits = floatBits(r2);
+            int k = static_cast<int>((bits >> shift_) - keyMin_);
+            float frac = static_cast<float>(bits & fracMask) * fracScale_;
+            const float* a = lj + 4 * k;
+            const float* c = coul + 4 * k;
+            fOverR[p] = ljScale * (a[0] + frac * a[1]) + qq * (c[0] + frac * c[1]);
+            energy[p] = ljScale * (a[2] + frac * a[3]) + qq * (c[2] + frac * c[3]);
+        } else {
+            // Inside the soft core |F| is constant: scale node 0 by rMin / r
+            float s = kSoftCore / std::sqrt(r2);
+            fOverR[p] = (ljScale * lj[0] + qq * coul[0]) * s;
+            energy[p] =  ljScale * lj[2] + qq * coul[2];
+        }
+    }
+}
+
+} // namespace physics
@@ -0,0 +1,75 @@
+#pragma once
+#include "pair_kernel.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace physics {
+
+/// Tabulated switched LJ and Coulomb kernels, interpolated linearly in r².
+///
+/// Nodes are spaced like float values: 2^tableBits nodes per octave of r²,
+/// so a lookup index is just the top bits of r²'s bit pattern (no sqrt, no
+/// pow) and the relative node spacing is the same at every distance. Each
+/// node stores {F/r, Δ(F/r), E, ΔE} so one 16-byte read serves a lookup.
+/// LJ tables exist per type pair present in the system; a single Coulomb
+/// table per unit charge product is shared by all pairs.
+class PotentialTable {
+public:
+    struct Settings {
+        float ljEpsilon  = 0;
+        float coulK      = 0;
+        float cutoff     = 0;
+        float switchDist = 0;
+        int   tableBits  = 7;
+        float ewaldBeta  = 0;          // > 0: Coulomb table holds the Ewald real-space term
+        bool operator==(const Settings& o) const {
+            return ljEpsilon == o.ljEpsilon && coulK == o.coulK && cutoff == o.cutoff &&
+                   switchDist == o.switchDist && tableBits == o.tableBits &&
+                   ewaldBeta == o.ewaldBeta;
+        }
+    };
+
+    /// Rebuild the tables if the settings or the set of species changed.
+    /// `present[z]` is nonzero for every type in the system. Returns true if
+    /// the tables were rebuilt.
+    bool update(const std::vector<char>& present, const Settings& settings);
+
+    /// Same contract as nonbondedPairForces(), evaluated from the tables.
+    void pairForces(const PairKernelInput& in, float* fOverR, float* energy) const;
+
+    /// Largest force deviation from the analytic kernel, sampled at interval
+    /// midpoints when the tables were built (LJ per pair, Coulomb per e²).
+    /// The relative figure skips samples where |F| < 1e-3 eV/Å.
+    float maxAbsForceError() const { return maxAbsError_; }
+    float maxRelForceError() const { return maxRelError_; }
+
+    size_t bytes() const { return floatCount_ * sizeof(float); }
+
+private:
+    struct AlignedDelete {
+        void operator()(float* p) const { ::operator delete[](p, std::align_val_t(64)); }
+    };
+
+    Settings settings_;
+    std::vector<char> builtFor_;      // species the tables cover
+    int typeCount_ = 0;
+    std::vector<int> slot_;           // [ta * typeCount + tb] → LJ table, -1 if none
+
+    std::unique_ptr<float[], AlignedDelete> data_;
+    size_t floatCount_ = 0;
+    int nodeCount_ = 0;               // nodes per table
+    uint32_t keyMin_ = 0;             // bit-pattern key of the first node
+    int shift_ = 0;                   // 23 - tableBits
+    float fracScale_ = 0;             // 2^-shift
+    float rMin2_ = 0, cutoff2_ = 0;
+
+    float maxAbsError_ = 0, maxRelError_ = 0;
+
+    const float* table(int t) const { return data_.get() + static_cast<size_t>(t) * nodeCount_ * 4; }
+    void fill(float* out, float sigma6, bool coulomb);
+};
+
+} // namespace physics
@@ -0,0 +1,51 @@
+#include "reaction_log.h"
+#include "bond_table.h"
+#include "element.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace physics {
+
+void ReactionLog::setCapacity(int capacity) {
+    std::vector<ReactionEvent> ring(std::max(capacity, 1));
+    uint64_t from = std::max(first(), total_ > ring.size() ? total_ - ring.size() : 0);
+    for (uint64_t seq = from; seq < total_; ++seq) ring[seq % ring.size()] = at(seq);
+    ring_.swap(ring);
+    first_ = from;
+}
+
+bool ReactionLog::openSpill(const std::string& path) {
+    closeSpill();
+    spill_ = std::fopen(path.c_str(), "wb");
+    if (!spill_) return false;
+    char header[16] = "RXNLOG01";
+    uint32_t recordSize = sizeof(ReactionEvent);
+    std::memcpy(header + 8, &recordSize, sizeof(recordSize));
+    std::fwrite(header, sizeof(header), 1, spill_);
+    return true;
+}
+
+void ReactionLog::closeSpill() {
+    if (spill_) std::fclose(spill_);
+    spill_ = nullptr;
+}
+
+std::string ReactionLog::format(const ReactionEvent& e) {
+    const PeriodicTable& pt = PeriodicTable::instance();
+    const std::string& a = pt.get(e.zA).symbol;
+    const std::string& b = pt.get(e.zB).symbol;
+
+    std::ostringstream oss;
+    if (e.kind == ReactionEvent::Broken) {
+        oss << a << "-" << b << " bond broken (T=" << e.temperature << "K)";
+    } else if (e.bondType == Bond::IONIC) {
+        oss << a << " + " << b << " -> ionic bond (dE=" << e.energy << "eV)";
+    } else {
+        const char* order = (e.order == 1) ? "single" : (e.order == 2) ? "double" : "triple";
+        oss << a << " + " << b << " -> " << order << " covalent bond (E=" << e.energy << "eV)";
+    }
+    return oss.str();
+}
+
+} // namespace physics
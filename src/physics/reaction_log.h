@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace physics {
+
+/// One bond formation or break, as a fixed-size POD record. Text is only
+/// built on request, by ReactionLog::format.
+struct ReactionEvent {
+    enum Kind : uint8_t { Formed, Broken };
+
+    float   time = 0;          // fs
+    int     idA = -1, idB = -1;// stable atom IDs (ionic: donor first)
+    float   energy = 0;        // eV — released on formation, bond strength on break
+    float   temperature = 0;   // K at the time of the event
+    Kind    kind = Formed;
+    uint8_t bondType = 0;      // Bond::Type
+    uint8_t order = 1;
+    uint8_t zA = 0, zB = 0;    // atomic numbers of A and B
+    uint8_t reserved[3] = {};  // explicit padding, so spilled records hold no stray bytes
+};
+static_assert(sizeof(ReactionEvent) == 28, "ReactionEvent must have no implicit padding");
+
+/// Bounded ring buffer of reaction events. Every event gets a sequence
+/// number; once the buffer is full the oldest are overwritten, so readers
+/// walk [first(), total()) and can tell how many they missed.
+///
+/// Optionally every event is also appended to a binary spill file, so the
+/// full history survives without growing memory: a 16-byte header (magic
+/// "RXNLOG01", record size, reserved) followed by raw ReactionEvent records.
+class ReactionLog {
+public:
+    explicit ReactionLog(int capacity = 4096) { setCapacity(capacity); }
+    ~ReactionLog() { closeSpill(); }
+    ReactionLog(const ReactionLog&) = delete;
+    ReactionLog& operator=(const ReactionLog&) = delete;
+
+    /// Resize the buffer, keeping the newest events that fit.
+    void setCapacity(int capacity);
+    int capacity() const { return static_cast<int>(ring_.size()); }
+
+    void push(const ReactionEvent& event) {
+        ring_[total_ % ring_.size()] = event;
+        ++total_;
+        if (spill_) std::fwrite(&event, sizeof(event), 1, spill_);
+    }
+
+    /// Drop the held events. Sequence numbers keep counting, so readers
+    /// holding a position never see it go backwards.
+    void clear() { first_ = total_; }
+
+    /// Events ever pushed (= sequence number of the next event).
+    uint64_t total() const { return total_; }
+    /// Oldest sequence number still held.
+    uint64_t first() const {
+        uint64_t oldest = total_ > ring_.size() ? total_ - ring_.size() : 0;
+        return first_ > oldest ? first_ : oldest;
+    }
+    int size() const { return static_cast<int>(total_ - first()); }
+    bool empty() const { return size() == 0; }
+
+    /// Event by sequence number, first() ≤ seq < total().
+    const ReactionEvent& at(uint64_t seq) const { return ring_[seq % ring_.size()]; }
+    const ReactionEvent& latest() const { return at(total_ - 1); }
+
+    /// Append every later event to a binary file (truncating it).
+    /// Returns false if the file can't be opened.
+    bool openSpill(const std::string& path);
+    void closeSpill();
+    bool spilling() const { return spill_ != nullptr; }
+
+    /// Human-readable description, e.g. "Na + Cl -> ionic bond (dE=4.1eV)".
+    static std::string format(const ReactionEvent& event);
+
+private:
+    std::vector<ReactionEvent> ring_;
+    uint64_t total_ = 0;
+    uint64_t first_ = 0;               // clear() point
+    std::FILE* spill_ = nullptr;
+};
+
+} // namespace physics
@@ -1,126 +1,564 @@
 #include "simulation.h"
+#include "morton.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace physics {
 
 Simulation::Simulation() = default;
 
 void Simulation::spawnAtom(int atomicNumber, glm::vec3 pos) {
-    Atom a;
-    a.init(atomicNumber);
-    a.pos = pos;
+    spawnAtoms({SpawnSpec{atomicNumber, pos}});
+}
 
-    // Thermal velocity distribution using Maxwell-Boltzmann
-    float kT = InteractionEngine::kB * interactions_.temperature;
-    float vrms = std::sqrt(3.0f * kT / a.mass); // simple 1D RMS velocity approximation
-    std::uniform_real_distribution<float> vdist(-vrms, vrms);
-    std::mt19937 rng(std::random_device{}());
-    a.vel = glm::vec3(vdist(rng), vdist(rng), vdist(rng));
+void Simulation::spawnAtoms(const std::vector<SpawnSpec>& specs) {
+    if (specs.empty()) return;
+    flushThermostat();
+    slowForcesValid_ = false;
+    energyValid_ = false;
+    bondScheduleValid_ = false;
+    atoms_.reserve(atoms_.size() + static_cast<int>(specs.size()));
 
-    atoms_.push_back(a);
+    // Maxwell-Boltzmann: each velocity component ~ N(0, kT/m)
+    float kT = InteractionEngine::kB * interactions_.temperature;
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    for (const auto& spec : specs) {
+        Atom a;
+        a.init(spec.atomicNumber);
+        float sigma = std::sqrt(kT / a.element->atomicMass);
+        glm::vec3 vel(sigma * gauss(rng_), sigma * gauss(rng_), sigma * gauss(rng_));
+        atoms_.add(a, spec.pos, vel);
+    }
 
-    // Update bonds since we added a new atom
+    // Bonds and molecules for the new atoms, once
+    syncBox();
+    interactions_.formStableOnly = adaptiveBonds;
     interactions_.updateBonds(atoms_);
-    tracker_.update(atoms_.data(), static_cast<int>(atoms_.size()));
+    tracker_.update(atoms_, box());
+    moleculesStale_ = false;
 }
 
 void Simulation::clear() {
     atoms_.clear();
+    thermostatScale_ = 1.0f;
+    slowForcesValid_ = false;
     interactions_.reactionLog.clear();
     simTime = 0.0f;
     stepCount = 0;
-    tracker_.update(atoms_.data(), 0);
+    lastDt = 0.0f;
+    adaptiveStep_ = 0.0f;
+    quietSteps_ = 0;
+    energyValid_ = false;
+    energyError_ = 0.0f;
+    dtHistory_.clear();
+    bondScheduleValid_ = false;
+    bondFullUpdates = bondPartialUpdates = 0;
+    bondAtomsChecked = 0;
+    interactions_.reindex(atoms_);
+    tracker_.update(atoms_, box());
+    moleculesStale_ = false;
+}
+
+void Simulation::removeAtoms(const std::vector<int>& indices) {
+    int n = atoms_.size();
+    std::vector<char> removed(n, 0);
+    for (int i : indices)
+        if (i >= 0 && i < n) removed[i] = 1;
+
+    // Bond energy bookkeeping; partners lose the bond and revalence
+    std::vector<int> order;
+    order.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (!removed[i]) { order.push_back(i); continue; }
+        for (const auto& e : atoms_.bonds().of(i))
+            if (!removed[e.otherAtomIdx] || e.otherAtomIdx > i)
+                interactions_.totalBondE -= atoms_.bonds()[e.bond].strength;
+    }
+    if (static_cast<int>(order.size()) == n) return;
+
+    applyLayout(order);
+    for (auto& a : atoms_) a.updateEffectiveValence();
+    tracker_.update(atoms_, box());
+    moleculesStale_ = false;
+    energyValid_ = false;
+}
+
+void Simulation::reorderAtoms(const std::vector<int>& order) {
+    if (static_cast<int>(order.size()) != atoms_.size()) return;
+    tracker_.remap(applyLayout(order));
+}
+
+void Simulation::spatialSort() {
+    int n = atoms_.size();
+    if (n < 2) return;
+
+    // 10 bits per axis over the box: ~0.1 Å cells for a 50 Å half-width
+    const float hw = worldSize, scale = 1024.0f / (2.0f * worldSize);
+    auto cell = [&](float p) {
+        return static_cast<uint32_t>(std::clamp(static_cast<int>((p + hw) * scale), 0, 1023));
+    };
+    sortKeys_.resize(n);
+    for (int i = 0; i < n; ++i) {
+        uint32_t code = mortonCode(cell(atoms_.x[i]), cell(atoms_.y[i]), cell(atoms_.z[i]));
+        sortKeys_[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(i);
+    }
+    std::sort(sortKeys_.begin(), sortKeys_.end());
+
+    std::vector<int> order(n);
+    bool sorted = true;
+    for (int k = 0; k < n; ++k) {
+        order[k] = static_cast<int>(sortKeys_[k] & 0xffffffffu);
+        sorted &= (order[k] == k);
+    }
+    if (!sorted) reorderAtoms(order);
 }
 
-void Simulation::berendsenThermostat(float dt, float targetT, float tau) {
-    if (atoms_.empty() || targetT < 1.0f) return;
+std::vector<int> Simulation::applyLayout(const std::vector<int>& order) {
+    int n = atoms_.size();
+    bool keepLayout = static_cast<int>(order.size()) == n;    // a pure permutation
+    bool keepSlow = slowForcesValid_ && keepLayout && static_cast<int>(slowFx_.size()) == n;
+    std::vector<int> newIndex = atoms_.reorder(order);
+    interactions_.reindex(atoms_);
+
+    // A permutation keeps the r-RESPA slow forces valid, in the new order
+    if (keepSlow) {
+        std::vector<float> scratch(n);
+        for (auto* f : {&slowFx_, &slowFy_, &slowFz_}) {
+            for (int k = 0; k < n; ++k) scratch[k] = (*f)[order[k]];
+            f->swap(scratch);
+        }
+    }
+    slowForcesValid_ = keepSlow;
 
-    // Calculate current temperature
-    float totalKE = 0;
-    for (const auto& a : atoms_) {
-        totalKE += 0.5f * a.mass * glm::dot(a.vel, a.vel);
+    // Likewise the bond scheduler's references; removals force a full update
+    if (bondScheduleValid_ && keepLayout && static_cast<int>(bondRecheck_.size()) == n) {
+        std::vector<float> scratch(n);
+        for (auto* r : {&bondRefX_, &bondRefY_, &bondRefZ_}) {
+            for (int k = 0; k < n; ++k) scratch[k] = (*r)[order[k]];
+            r->swap(scratch);
+        }
+        std::vector<char> recheck(n);
+        for (int k = 0; k < n; ++k) recheck[k] = bondRecheck_[order[k]];
+        bondRecheck_.swap(recheck);
+    } else {
+        bondScheduleValid_ = false;
     }
-    // T = (2/3) * (KE / N) / kB
-    float currentT = (2.0f / 3.0f) * (totalKE / atoms_.size()) / InteractionEngine::kB;
+    return newIndex;
+}
+
+float Simulation::berendsenScale(float dt, double kineticEnergy, float targetT, float tau) const {
+    if (atoms_.empty() || targetT < 1.0f) return 1.0f;
+
+    // T = 2 KE / (Nf kB), Nf = 3N minus one per bond constraint
+    int dof = std::max(3 * atoms_.size() - constraintSolver_.count(), 1);
+    float currentT = 2.0f * static_cast<float>(kineticEnergy / dof) / InteractionEngine::kB;
     if (currentT < 1.0f) currentT = 1.0f;
 
     // Scale factor
     float lambda = std::sqrt(1.0f + (dt / tau) * ((targetT / currentT) - 1.0f));
 
     // Prevent extreme scaling in a single step
-    lambda = std::clamp(lambda, 0.9f, 1.1f);
-
-    for (auto& a : atoms_) {
-        a.vel *= lambda;
-    }
+    return std::clamp(lambda, 0.9f, 1.1f);
 }
 
 void Simulation::step(float dt) {
     if (atoms_.empty()) return;
+    if (sortInterval > 0 && stepCount % sortInterval == 0) spatialSort();
+    if (adaptiveDt) dt = chooseDt(dt);
+    if (dt != lastDt) dtHistory_.push_back({stepCount, simTime, dt});
+    lastDt = dt;
+    int inner = std::max(respaSteps, 1);
+    interactions_.simTime = simTime;
+    syncBox();
+    constraintSolver_.update(atoms_, interactions_.bonded(), constraints, box());
 
-    // ── Velocity Verlet Integration ──
+    double kinetic;
+    if (inner > 1) {
+        kinetic = respaStep(dt, inner);
+    } else {
+        slowForcesValid_ = false;
 
-    // 1. Half-kick v(t + dt/2) = v(t) + 0.5*a(t)*dt
-    for (auto& a : atoms_) {
-        if (a.mass > 0) {
-            float invMass = 1.0f / a.mass;
-            a.vel += 0.5f * dt * a.force * invMass;
-        }
+        // ── Velocity Verlet Integration ──
+        // Two sweeps per step: (last step's thermostat scale +) half-kick +
+        // drift + boundary, then half-kick + kinetic energy.
+        // (massless atoms have invMass = 0 and are not kicked)
+
+        // 1. v(t + dt/2) = λv(t) + 0.5*a(t)*dt, r(t + dt) = r(t) + v(t + dt/2)*dt
+        //    (then SHAKE, with constraints)
+        constrainedKickDrift(dt);
+
+        // 2. Update Forces a(t + dt)
+        interactions_.computeForces(atoms_);
+
+        // 3. v(t + dt) = v(t + dt/2) + 0.5*a(t+dt)*dt
+        kinetic = kick(dt);
     }
 
-    // 2. Drift r(t + dt) = r(t) + v(t + dt/2)*dt
-    for (auto& a : atoms_) {
-        a.pos += dt * a.vel;
-        applyBoundary(a);
+    // RATTLE: drop velocity components along constrained bonds
+    if (constraintSolver_.active()) {
+        constraintSolver_.rattle(atoms_, dt, box(), interactions_.pool());
+        kinetic = kineticEnergy();
     }
 
-    // 3. Update Forces a(t + dt)
-    interactions_.simTime = simTime;
-    interactions_.computeForces(atoms_);
+    // ── Thermostat ──
+    // Apply temperature control (tau = 100.0f is a typical relaxation time).
+    // The scale is folded into the next step's first sweep; KE is reported
+    // as if it had already been applied.
+    thermostatScale_ = berendsenScale(inner * dt, kinetic, interactions_.temperature, 100.0f);
+    interactions_.totalKE = static_cast<float>(kinetic * thermostatScale_ * thermostatScale_);
+
+    // Energy change over the step, for the adaptive controller. Measured
+    // before the rescale, so only integration error counts; the rescaled
+    // energy is the reference for the next step.
+    double energy = kinetic + interactions_.totalPE;
+    energyError_ = energyValid_ ? static_cast<float>(std::abs(energy - lastEnergy_) / atoms_.size())
+                                : 0.0f;
+    lastEnergy_ = static_cast<double>(interactions_.totalKE) + interactions_.totalPE;
+    energyValid_ = true;
+
+    // ── Emergent Chemistry (Bond updates) ──
+    scheduledBondUpdate();
 
-    // 4. Half-kick v(t + dt) = v(t + dt/2) + 0.5*a(t+dt)*dt
-    for (auto& a : atoms_) {
-        if (a.mass > 0) {
-            float invMass = 1.0f / a.mass;
-            a.vel += 0.5f * dt * a.force * invMass;
+    // Molecules follow bond changes at most every bondInterval steps
+    if (moleculesStale_ && stepCount % std::max(bondInterval, 1) == 0) {
+        tracker_.update(atoms_, box());
+        moleculesStale_ = false;
+    }
+
+    simTime += inner * dt;
+    stepCount++;
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Bond update scheduling
+// ═══════════════════════════════════════════════════════════
+void Simulation::scheduledBondUpdate() {
+    const int n = atoms_.size();
+    // Adaptive: a bond that breaks at once would re-flag its atoms through
+    // markBreakingBonds every step, so such bonds are not formed at all
+    interactions_.formStableOnly = adaptiveBonds;
+    const std::vector<char>* active = nullptr;         // null: every atom
+    if (!adaptiveBonds) {
+        // We don't need to check bonds every single integration step.
+        // Checking every few steps saves massive CPU time and allows
+        // atoms to vibrate naturally before forming/breaking bonds.
+        if (stepCount % std::max(bondInterval, 1) != 0) return;
+        bondScheduleValid_ = false;
+    } else {
+        bool full = !bondScheduleValid_ || static_cast<int>(bondRecheck_.size()) != n ||
+                    interactions_.temperature != bondTemperature_ ||
+                    stepCount - lastFullBondStep_ >= bondMaxInterval;
+        if (!full) {
+            int count = markBondActive();
+            if (count == 0) return;
+            // Past half the atoms, the half-shell full pass is cheaper
+            if (2 * count <= n) active = &bondActive_;
         }
     }
 
-    // ── Thermostat ──
-    // Apply temperature control (tau = 100.0f is a typical relaxation time)
-    berendsenThermostat(dt, interactions_.temperature, 100.0f);
+    int oldCount = interactions_.bondFormedCount - interactions_.bondBrokenCount;
+    int oldEvents = interactions_.bondFormedCount + interactions_.bondBrokenCount;
+    interactions_.updateBonds(atoms_, active);
+    int newCount = interactions_.bondFormedCount - interactions_.bondBrokenCount;
 
-    // ── Emergent Chemistry (Bond updates) ──
-    // We don't need to check bonds every single integration step.
-    // Checking every 10 steps saves massive CPU time and allows
-    // atoms to vibrate naturally before forming/breaking bonds.
-    if (stepCount % 10 == 0) {
-        int oldCount = interactions_.bondFormedCount - interactions_.bondBrokenCount;
-        interactions_.updateBonds(atoms_);
-        int newCount = interactions_.bondFormedCount - interactions_.bondBrokenCount;
-
-        // If bonds changed, update molecules
-        if (oldCount != newCount || stepCount == 0) {
-            tracker_.update(atoms_.data(), static_cast<int>(atoms_.size()));
+    if (active) {
+        ++bondPartialUpdates;
+        bondAtomsChecked += std::count(bondActive_.begin(), bondActive_.end(), 1);
+    } else {
+        ++bondFullUpdates;
+        bondAtomsChecked += n;
+    }
+    if (adaptiveBonds) {
+        resetBondReference(active);
+        if (!active) {
+            lastFullBondStep_ = stepCount;
+            bondTemperature_ = interactions_.temperature;
         }
     }
 
-    simTime += dt;
-    stepCount++;
+    // Bond energy jumps are not integration error
+    if (interactions_.bondFormedCount + interactions_.bondBrokenCount != oldEvents)
+        energyValid_ = false;
+
+    // If bonds changed, molecules need an update
+    if (oldCount != newCount || stepCount == 0) moleculesStale_ = true;
+}
+
+int Simulation::markBondActive() {
+    const int n = atoms_.size();
+    const Box b = box();
+    bondActive_.assign(n, 0);
+
+    // Drift since each atom's last check. A pair last checked from one
+    // atom has since moved apart by at most that atom's drift plus twice
+    // the other's (its drift before and after), so a reach of bondSkin/3
+    // per atom bounds the unchecked change to bondSkin.
+    //
+    // An update is due once any atom passes its reach, and then also takes
+    // every atom past half of it, so updates come in batches rather than
+    // one straggler per step. Atoms that reacted join the next update, at
+    // most bondInterval steps away.
+    const float reach = bondSkin / 3.0f, reach2 = reach * reach;
+    bool due = stepCount >= recheckStep_;
+    for (int i = 0; i < n; ++i) {
+        float dx = b.minimumImage(atoms_.x[i] - bondRefX_[i]);
+        float dy = b.minimumImage(atoms_.y[i] - bondRefY_[i]);
+        float dz = b.minimumImage(atoms_.z[i] - bondRefZ_[i]);
+        float d2 = dx * dx + dy * dy + dz * dz;
+        due |= (d2 > reach2);
+        bondActive_[i] = (d2 > 0.25f * reach2) || bondRecheck_[i];
+    }
+
+    // Bond lengths are cheap to test directly, so breaking is exact
+    due |= interactions_.markBreakingBonds(atoms_, bondActive_) > 0;
+    if (!due) return 0;
+    return static_cast<int>(std::count(bondActive_.begin(), bondActive_.end(), 1));
+}
+
+void Simulation::resetBondReference(const std::vector<char>* active) {
+    const int n = atoms_.size();
+    if (!active) {
+        bondRefX_.resize(n); bondRefY_.resize(n); bondRefZ_.resize(n);
+        bondRecheck_.resize(n);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (active && !(*active)[i]) continue;
+        bondRefX_[i] = atoms_.x[i]; bondRefY_[i] = atoms_.y[i]; bondRefZ_[i] = atoms_.z[i];
+        bondRecheck_[i] = 0;
+    }
+    // Valence and charge changed: their other pairs need another look.
+    // Every pending recheck was just included, so only these remain.
+    const auto& reacted = interactions_.reactedAtoms();
+    for (int i : reacted) bondRecheck_[i] = 1;
+    recheckStep_ = reacted.empty() ? std::numeric_limits<int>::max()
+                                   : stepCount + std::max(bondInterval, 1);
+    bondScheduleValid_ = true;
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Adaptive time step
+// ═══════════════════════════════════════════════════════════
+float Simulation::chooseDt(float requested) {
+    if (adaptiveStep_ <= 0.0f) adaptiveStep_ = requested;
+    float next = adaptiveStep_;
+
+    // Velocity Verlet's energy error scales as dt², so shrink by
+    // √(tolerance / error); a non-finite error halves the step
+    if (!(energyError_ <= dtEnergyTolerance)) {
+        float s = std::isfinite(energyError_) ? std::sqrt(dtEnergyTolerance / energyError_) : 0.5f;
+        next *= std::clamp(s, 0.5f, 0.9f);
+        quietSteps_ = 0;
+    } else if (energyError_ < 0.25f * dtEnergyTolerance) {
+        // Grow only after a run of quiet steps, so dt does not flicker
+        if (++quietSteps_ >= 10) { next *= dtGrowth; quietSteps_ = 0; }
+    } else {
+        quietSteps_ = 0;
+    }
+
+    next = std::min(next, displacementLimitedDt());
+
+    // Snap down onto the ladder dtMin·dtGrowthᵏ, so dt moves in discrete
+    // steps and dtHistory stays short
+    if (next > dtMin && dtGrowth > 1.0f) {
+        float k = std::floor(std::log(next / dtMin) / std::log(dtGrowth) + 1e-3f);
+        next = dtMin * std::pow(dtGrowth, k);
+    }
+    next = std::clamp(next, dtMin, dtMax);
+    adaptiveStep_ = next;
+    return next;
+}
+
+float Simulation::displacementLimitedDt() const {
+    const int n = atoms_.size();
+    const bool slow = slowForcesValid_ && static_cast<int>(slowFx_.size()) == n;
+    float maxV2 = 0.0f, maxA2 = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        float fx = atoms_.fx[i], fy = atoms_.fy[i], fz = atoms_.fz[i];
+        if (slow) { fx += slowFx_[i]; fy += slowFy_[i]; fz += slowFz_[i]; }
+        float w2 = atoms_.invMass[i] * atoms_.invMass[i];
+        maxV2 = std::max(maxV2, atoms_.vx[i] * atoms_.vx[i] + atoms_.vy[i] * atoms_.vy[i] +
+                                atoms_.vz[i] * atoms_.vz[i]);
+        maxA2 = std::max(maxA2, w2 * (fx * fx + fy * fy + fz * fz));
+    }
+    if (!std::isfinite(maxV2) || !std::isfinite(maxA2)) return dtMin;
+
+    // Positive root of ½a·dt² + v·dt = D
+    float v = std::sqrt(maxV2), a = std::sqrt(maxA2), D = dtMaxDisplacement;
+    if (a < 1e-12f) return v > 0.0f ? D / v : dtMax;
+    return (std::sqrt(v * v + 2.0f * a * D) - v) / a;
 }
 
-void Simulation::applyBoundary(Atom& a) {
-    float hw = worldSize;
-    // Reflective box boundary
+// ═══════════════════════════════════════════════════════════
+//  Fused integrator sweeps
+// ═══════════════════════════════════════════════════════════
+void Simulation::kickDrift(float dt) {
+    const int n = atoms_.size();
+    const float lambda = thermostatScale_;
+    const float hw = worldSize, L = 2.0f * worldSize, invL = 1.0f / L;
+    const bool periodic = (boundary == Boundary::Periodic);
+    thermostatScale_ = 1.0f;
+
+    float* x[3] = {atoms_.x.data(),  atoms_.y.data(),  atoms_.z.data()};
+    float* v[3] = {atoms_.vx.data(), atoms_.vy.data(), atoms_.vz.data()};
+    const float* f[3] = {atoms_.fx.data(), atoms_.fy.data(), atoms_.fz.data()};
+    int* image[3] = {atoms_.imageX.data(), atoms_.imageY.data(), atoms_.imageZ.data()};
+    const float* invMass = atoms_.invMass.data();
+
+    // One axis at a time: each loop streams four arrays with no
+    // cross-iteration dependencies, so it vectorises
     for (int axis = 0; axis < 3; ++axis) {
-        if (a.pos[axis] > hw) {
-            a.pos[axis] = hw;
-            a.vel[axis] *= -0.5f; // lose some energy on bounce
-        } else if (a.pos[axis] < -hw) {
-            a.pos[axis] = -hw;
-            a.vel[axis] *= -0.5f;
+        float* __restrict xa = x[axis];
+        float* __restrict va = v[axis];
+        const float* __restrict fa = f[axis];
+        int* __restrict ia = image[axis];
+        if (periodic) {
+            for (int i = 0; i < n; ++i) {
+                float vi = lambda * va[i] + 0.5f * dt * invMass[i] * fa[i];
+                float xi = xa[i] + dt * vi;
+                float shift = std::floor((xi + hw) * invL);   // Box::wrap
+                va[i] = vi;
+                xa[i] = xi - shift * L;
+                ia[i] += static_cast<int>(shift);
+            }
+        } else {
+            // Reflective box boundary: clamp to the wall and bounce
+            for (int i = 0; i < n; ++i) {
+                float vi = lambda * va[i] + 0.5f * dt * invMass[i] * fa[i];
+                float xi = xa[i] + dt * vi;
+                bool outside = (xi > hw) | (xi < -hw);
+                va[i] = outside ? -0.5f * vi : vi;    // lose some energy on bounce
+                xa[i] = std::min(std::max(xi, -hw), hw);
+            }
         }
     }
 }
 
+double Simulation::kick(float dt) {
+    const int n = atoms_.size();
+    float* __restrict vx = atoms_.vx.data();
+    float* __restrict vy = atoms_.vy.data();
+    float* __restrict vz = atoms_.vz.data();
+    const float* __restrict fx = atoms_.fx.data();
+    const float* __restrict fy = atoms_.fy.data();
+    const float* __restrict fz = atoms_.fz.data();
+    const float* __restrict mass = atoms_.mass.data();
+    const float* __restrict invMass = atoms_.invMass.data();
+
+    // Σ m v², in float blocks summed into a double
+    constexpr int kBlock = 256;
+    double twiceKE = 0.0;
+    for (int begin = 0; begin < n; begin += kBlock) {
+        int end = std::min(begin + kBlock, n);
+        float sum = 0.0f;
+        for (int i = begin; i < end; ++i) {
+            float h = 0.5f * dt * invMass[i];
+            float a = vx[i] + h * fx[i];
+            float b = vy[i] + h * fy[i];
+            float c = vz[i] + h * fz[i];
+            vx[i] = a; vy[i] = b; vz[i] = c;
+            sum += mass[i] * (a * a + b * b + c * c);
+        }
+        twiceKE += sum;
+    }
+    return 0.5 * twiceKE;
+}
+
+double Simulation::kineticEnergy() const {
+    double twiceKE = 0.0;
+    for (int i = 0; i < atoms_.size(); ++i)
+        twiceKE += atoms_.mass[i] * (atoms_.vx[i] * atoms_.vx[i] + atoms_.vy[i] * atoms_.vy[i] +
+                                     atoms_.vz[i] * atoms_.vz[i]);
+    return 0.5 * twiceKE;
+}
+
+void Simulation::constrainedKickDrift(float dt) {
+    if (!constraintSolver_.active()) { kickDrift(dt); return; }
+    Box b = box();
+    constraintSolver_.beginStep(atoms_, b);
+    kickDrift(dt);
+    constraintSolver_.shake(atoms_, dt, b, interactions_.pool());
+}
+
+// ═══════════════════════════════════════════════════════════
+//  r-RESPA (Tuckerman, Berne & Martyna 1992)
+//  Non-bonded forces kick for K·dt/2 at both ends of the outer step;
+//  in between, K velocity Verlet steps of dt with bonded forces only.
+// ═══════════════════════════════════════════════════════════
+double Simulation::respaStep(float dt, int inner) {
+    // Both force groups at the current positions, after spawns or when
+    // switching over from plain velocity Verlet
+    if (!slowForcesValid_ || static_cast<int>(slowFx_.size()) != atoms_.size()) {
+        computeSlowForces();
+        interactions_.computeForces(atoms_, InteractionEngine::ForceGroup::Bonded);
+        slowForcesValid_ = true;
+    }
+
+    float slowH = 0.5f * inner * dt;
+    slowKick(slowH);
+    for (int k = 0; k < inner; ++k) {
+        constrainedKickDrift(dt);
+        interactions_.computeForces(atoms_, InteractionEngine::ForceGroup::Bonded);
+        kick(dt);
+    }
+    computeSlowForces();
+    return slowKick(slowH);
+}
+
+void Simulation::computeSlowForces() {
+    // Evaluate into the store's force arrays, then swap them out so the
+    // bonded forces stay in place
+    int n = atoms_.size();
+    slowFx_.resize(n); slowFy_.resize(n); slowFz_.resize(n);
+    atoms_.fx.swap(slowFx_); atoms_.fy.swap(slowFy_); atoms_.fz.swap(slowFz_);
+    interactions_.computeForces(atoms_, InteractionEngine::ForceGroup::Nonbonded);
+    atoms_.fx.swap(slowFx_); atoms_.fy.swap(slowFy_); atoms_.fz.swap(slowFz_);
+}
+
+double Simulation::slowKick(float h) {
+    const int n = atoms_.size();
+    const float lambda = thermostatScale_;
+    thermostatScale_ = 1.0f;
+    float* __restrict vx = atoms_.vx.data();
+    float* __restrict vy = atoms_.vy.data();
+    float* __restrict vz = atoms_.vz.data();
+    const float* __restrict fx = slowFx_.data();
+    const float* __restrict fy = slowFy_.data();
+    const float* __restrict fz = slowFz_.data();
+    const float* __restrict mass = atoms_.mass.data();
+    const float* __restrict invMass = atoms_.invMass.data();
+
+    constexpr int kBlock = 256;
+    double twiceKE = 0.0;
+    for (int begin = 0; begin < n; begin += kBlock) {
+        int end = std::min(begin + kBlock, n);
+        float sum = 0.0f;
+        for (int i = begin; i < end; ++i) {
+            float s = h * invMass[i];
+            float a = lambda * vx[i] + s * fx[i];
+            float b = lambda * vy[i] + s * fy[i];
+            float c = lambda * vz[i] + s * fz[i];
+            vx[i] = a; vy[i] = b; vz[i] = c;
+            sum += mass[i] * (a * a + b * b + c * c);
+        }
+        twiceKE += sum;
+    }
+    return 0.5 * twiceKE;
+}
+
+void Simulation::flushThermostat() {
+    if (thermostatScale_ == 1.0f) return;
+    for (int i = 0; i < atoms_.size(); ++i) {
+        atoms_.vx[i] *= thermostatScale_;
+        atoms_.vy[i] *= thermostatScale_;
+        atoms_.vz[i] *= thermostatScale_;
+    }
+    thermostatScale_ = 1.0f;
+}
+
+void Simulation::syncBox() {
+    interactions_.worldSize = worldSize;
+    interactions_.periodic = (boundary == Boundary::Periodic);
+}
+
 } // namespace physics
@@ -1,8 +1,11 @@
 #pragma once
-#include "atom.h"
+#include "atom_store.h"
+#include "constraints.h"
 #include "interaction.h"
 #include "quantum.h"
 #include "molecule.h"
+#include "structures.h"
+#include <random>
 #include <vector>
 
 namespace physics {
@@ -12,42 +15,216 @@ class Simulation {
 public:
     Simulation();
 
-    /// Advance the simulation by dt seconds.
+    /// Advance the simulation by one step: dt (fs), or respaSteps·dt
+    /// with multiple time stepping. With adaptiveDt the controller picks
+    /// the step size and dt only seeds it (first step, or after clear()).
     void step(float dt);
 
     /// Add an atom of the given element at a position.
     void spawnAtom(int atomicNumber, glm::vec3 pos);
 
+    /// Append many atoms at once, with Maxwell–Boltzmann velocities at the
+    /// engine temperature drawn from the simulation's RNG stream. Bonding
+    /// and molecule detection run once, after the last atom.
+    void spawnAtoms(const std::vector<SpawnSpec>& specs);
+
+    /// Reseed the RNG behind spawn velocities (and structure builders that
+    /// take rng()), for reproducible set-ups.
+    void seed(uint32_t value) { rng_.seed(value); }
+    std::mt19937& rng() { return rng_; }
+
     /// Remove all atoms and molecules.
     void clear();
 
+    /// Remove atoms by index. Their bonds are dropped (partners keep any
+    /// ionic charge) and the remaining atoms are compacted in order, so
+    /// indices shift; atoms().id() / indexOf() give stable handles.
+    void removeAtom(int index) { removeAtoms({index}); }
+    void removeAtoms(const std::vector<int>& indices);
+
+    /// Permute the atoms: new index k holds old index order[k], which
+    /// must list every index once. Bonds and molecules follow.
+    void reorderAtoms(const std::vector<int>& order);
+
+    /// Reorder the atoms along a Morton (Z-order) curve of their
+    /// positions, so atoms close in space are close in memory.
+    void spatialSort();
+
     // Public access to state
-    std::vector<Atom>& atoms() { return atoms_; }
-    const std::vector<Atom>& atoms() const { return atoms_; }
+    AtomStore& atoms() { return atoms_; }
+    const AtomStore& atoms() const { return atoms_; }
 
     const std::vector<Molecule>& molecules() const { return tracker_.molecules(); }
 
+    /// Current box geometry (for minimum-image separations).
+    Box box() const { return Box{worldSize, boundary == Boundary::Periodic}; }
+
     InteractionEngine& interactions() { return interactions_; }
-    const std::vector<InteractionEngine::ReactionEvent>& reactionLog() const {
-        return interactions_.reactionLog;
-    }
+    const ReactionLog& reactionLog() const { return interactions_.reactionLog; }
 
     // World state
-    float worldSize = 50.0f;
+    enum class Boundary { Reflective, Periodic };
+    Boundary boundary = Boundary::Reflective;
+    float worldSize = 50.0f;               // box half-width (Å)
     float simTime = 0.0f;
     int stepCount = 0;
 
+    // r-RESPA multiple time stepping: bonded (Morse + angle) forces every
+    // dt, non-bonded forces every respaSteps·dt. 1 = plain velocity Verlet.
+    // Bond updates are scheduled per step() call.
+    int respaSteps = 1;
+
+    // Bond update scheduling. Fixed: every bondInterval steps. Adaptive:
+    // bonds are checked only around atoms whose state could have crossed
+    // a threshold — both atoms of a bond that would break now, atoms that
+    // moved more than bondSkin/3 since their last check (so no candidate
+    // pair's distance has drifted by more than bondSkin unchecked), and
+    // atoms that reacted, within bondInterval steps. All atoms are checked
+    // every bondMaxInterval steps and when the temperature changes. It also
+    // sets InteractionEngine::formStableOnly, so bonds that would break at
+    // the next check are not formed.
+    //
+    // bondSkin trades accuracy for speed: a pair can pass through the
+    // covalent formation window (about ±rₑ/2 around rₑ) unchecked if the
+    // skin is wider than that. 0.3 Å is roughly the drift of the fixed
+    // 10-step cadence; at that skin hot systems update nearly every step,
+    // so the adaptive schedule is opt-in.
+    bool  adaptiveBonds   = false;
+    int   bondInterval    = 10;        // steps between updates (fixed)
+    float bondSkin        = 0.3f;      // Å — max unchecked pair-distance drift (adaptive)
+    int   bondMaxInterval = 1000;      // steps between full updates (adaptive)
+
+    // Bond update statistics since clear()
+    int       bondFullUpdates = 0, bondPartialUpdates = 0;
+    long long bondAtomsChecked = 0;
+
+    // Steps between spatial sorts (0 = never). Each sort costs one
+    // neighbour-list rebuild; atom indices change, IDs do not.
+    int sortInterval = 1000;
+
+    // Holonomic bond constraints (SHAKE/RATTLE) on X–H bonds or all bonds,
+    // removing bond stretching from the step-size limit. Constrained bonds
+    // are held at rₑ, so they no longer break by stretching. The thermostat
+    // counts 3N − Nc degrees of freedom.
+    ConstraintSolver::Settings constraints;
+    const ConstraintSolver& constraintSolver() const { return constraintSolver_; }
+
+    // Adaptive time step. Before each step, dt is capped so the fastest
+    // atom moves at most dtMaxDisplacement (from its current speed and
+    // acceleration); it shrinks when the last step's energy error exceeded
+    // dtEnergyTolerance and grows by dtGrowth after 10 steps well below,
+    // always within [dtMin, dtMax]. With r-RESPA this is the inner step.
+    bool  adaptiveDt         = false;
+    float dtMin              = 0.05f;  // fs
+    float dtMax              = 2.0f;   // fs
+    float dtMaxDisplacement  = 0.1f;   // Å per step, fastest atom
+    float dtEnergyTolerance  = 1e-4f;  // eV per atom, |ΔE| over one step
+    float dtGrowth           = 1.1f;   // max increase per step
+    float lastDt             = 0.0f;   // step size of the last step() (fs)
+
+    /// Step size in effect from `step` (the step() count) at `time` (fs).
+    struct DtChange {
+        int step;
+        float time;
+        float dt;
+    };
+    /// Every change of step size since clear(), in order; fixed-dt runs
+    /// record one entry per distinct dt passed to step().
+    const std::vector<DtChange>& dtHistory() const { return dtHistory_; }
+
 private:
-    std::vector<Atom> atoms_;
+    AtomStore         atoms_;
     InteractionEngine interactions_;
     MoleculeTracker   tracker_;
     QuantumSampler    sampler_;
+    std::mt19937      rng_{std::random_device{}()};
+    ConstraintSolver  constraintSolver_;
+    std::vector<DtChange> dtHistory_;
+    std::vector<uint64_t> sortKeys_;   // (Morton code << 32) | index
+
+    // Adaptive dt controller state
+    float  adaptiveStep_ = 0.0f;       // controller dt (0 = not seeded)
+    double lastEnergy_ = 0.0;          // KE + PE after the last step, thermostat rescale applied
+    bool   energyValid_ = false;       // lastEnergy_ comparable with the next step
+    float  energyError_ = 0.0f;        // |ΔE| per atom over the last step
+    int    quietSteps_ = 0;            // consecutive steps well under tolerance
+
+    // Adaptive bond scheduler state
+    std::vector<float> bondRefX_, bondRefY_, bondRefZ_;  // positions at each atom's last check
+    std::vector<char>  bondRecheck_;   // reacted since their last check
+    std::vector<char>  bondActive_;    // atoms to check this step
+    int   recheckStep_ = 0;            // step by which pending rechecks force an update
+    int   lastFullBondStep_ = 0;
+    float bondTemperature_ = 0.0f;     // engine temperature at the last full update
+    bool  bondScheduleValid_ = false;  // reference arrays match the atoms
+    bool  moleculesStale_ = false;     // bonds changed since the last tracker update
+
+    // Berendsen velocity scale from the last step, applied by the next
+    // kickDrift() so the thermostat needs no sweep of its own. Flushed
+    // before atoms are added.
+    float thermostatScale_ = 1.0f;
+
+    // ── Fused velocity Verlet sweeps over the SoA arrays ──
+    /// v ← λv + ½dt·f/m, x ← x + dt·v, then the box boundary (reflect off
+    /// the walls, or wrap and update the image flags).
+    void kickDrift(float dt);
+
+    /// v ← v + ½dt·f/m. Returns the kinetic energy of the new velocities.
+    double kick(float dt);
+
+    /// Σ ½mv² over the current velocities.
+    double kineticEnergy() const;
+
+    /// kickDrift(), then SHAKE back onto the constrained bond lengths.
+    void constrainedKickDrift(float dt);
+
+    /// The adaptive controller's step size for the next step.
+    float chooseDt(float requested);
+
+    /// Largest dt for which the fastest atom moves at most
+    /// dtMaxDisplacement: |v|dt + ½|a|dt² with the largest |v| and |a|.
+    float displacementLimitedDt() const;
+
+    // ── r-RESPA ──
+    std::vector<float> slowFx_, slowFy_, slowFz_;  // non-bonded forces (eV/Å)
+    bool slowForcesValid_ = false;
+
+    /// One outer step of `inner` bonded sub-steps. Returns the final KE.
+    double respaStep(float dt, int inner);
+
+    /// Non-bonded forces into the slow arrays; store forces untouched.
+    void computeSlowForces();
+
+    /// v ← λv + h·f_slow/m (λ: pending thermostat scale). Returns the KE.
+    double slowKick(float h);
+
+    /// Apply a pending thermostat scale to every velocity now.
+    void flushThermostat();
+
+    /// AtomStore::reorder, then refresh the engine's index-based caches
+    /// and carry over (or, after removals, drop) the r-RESPA slow forces.
+    /// Returns the old → new map.
+    std::vector<int> applyLayout(const std::vector<int>& order);
+
+    // ── Bond update scheduling ──
+    /// Run this step's bond update, if the schedule calls for one, and
+    /// refresh molecules when bonds changed.
+    void scheduledBondUpdate();
+
+    /// Flag the atoms the adaptive schedule must check this step in
+    /// bondActive_. Returns how many there are.
+    int markBondActive();
+
+    /// Take new reference positions for the atoms just checked (all, if
+    /// active is null); atoms that reacted are checked again next step.
+    void resetBondReference(const std::vector<char>* active);
 
-    /// Keep atoms inside the simulation box.
-    void applyBoundary(Atom& a);
+    /// Push box size and boundary mode to the interaction engine.
+    void syncBox();
 
-    /// Berendsen thermostat for temperature control.
-    void berendsenThermostat(float dt, float targetT, float tau = 100.0f);
+    /// Berendsen thermostat: velocity scale that relaxes the temperature
+    /// implied by kineticEnergy toward targetT.
+    float berendsenScale(float dt, double kineticEnergy, float targetT, float tau = 100.0f) const;
 };
 
 } // namespace physics
@@ -0,0 +1,198 @@
+#include "structures.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace physics {
+
+// ═══════════════════════════════════════════════════════════
+//  Crystal lattices
+// ═══════════════════════════════════════════════════════════
+struct BasisAtom {
+    int atomicNumber;
+    float u, v, w;                 // fractional position in the cubic cell
+};
+
+static std::vector<SpawnSpec> cubicLattice(const std::vector<BasisAtom>& basis, float a,
+                                           glm::ivec3 cells, glm::vec3 centre) {
+    int nx = std::max(cells.x, 0), ny = std::max(cells.y, 0), nz = std::max(cells.z, 0);
+    glm::vec3 origin = centre - 0.5f * a * glm::vec3(static_cast<float>(nx),
+                                                     static_cast<float>(ny),
+                                                     static_cast<float>(nz));
+    std::vector<SpawnSpec> out;
+    out.reserve(static_cast<size_t>(nx) * ny * nz * basis.size());
+    for (int ix = 0; ix < nx; ++ix)
+    for (int iy = 0; iy < ny; ++iy)
+    for (int iz = 0; iz < nz; ++iz) {
+        for (const auto& b : basis) {
+            glm::vec3 p = origin + a * glm::vec3(ix + b.u, iy + b.v, iz + b.w);
+            out.push_back({b.atomicNumber, p});
+        }
+    }
+    return out;
+}
+
+std::vector<SpawnSpec> fccLattice(int atomicNumber, float a, glm::ivec3 cells, glm::vec3 centre) {
+    return cubicLattice({{atomicNumber, 0.0f, 0.0f, 0.0f}, {atomicNumber, 0.5f, 0.5f, 0.0f},
+                         {atomicNumber, 0.5f, 0.0f, 0.5f}, {atomicNumber, 0.0f, 0.5f, 0.5f}},
+                        a, cells, centre);
+}
+
+std::vector<SpawnSpec> bccLattice(int atomicNumber, float a, glm::ivec3 cells, glm::vec3 centre) {
+    return cubicLattice({{atomicNumber, 0.0f, 0.0f, 0.0f}, {atomicNumber, 0.5f, 0.5f, 0.5f}},
+                        a, cells, centre);
+}
+
+std::vector<SpawnSpec> rockSaltLattice(int cationZ, int anionZ, float a, glm::ivec3 cells,
+                                       glm::vec3 centre) {
+    return cubicLattice({{cationZ, 0.0f, 0.0f, 0.0f}, {cationZ, 0.5f, 0.5f, 0.0f},
+                         {cationZ, 0.5f, 0.0f, 0.5f}, {cationZ, 0.0f, 0.5f, 0.5f},
+                         {anionZ,  0.5f, 0.0f, 0.0f}, {anionZ,  0.0f, 0.5f, 0.0f},
+                         {anionZ,  0.0f, 0.0f, 0.5f}, {anionZ,  0.5f, 0.5f, 0.5f}},
+                        a, cells, centre);
+}
+
+// ═══════════════════════════════════════════════════════════
+//  Overlap tests for random placement
+// ═══════════════════════════════════════════════════════════
+// Points bucketed into cells at least `radius` wide, so any point within
+// radius of a query lies in the 27 surrounding cells. Points outside
+// [lo, hi] are clamped into the boundary cells, which keeps that guarantee.
+class PointGrid {
+public:
+    PointGrid(glm::vec3 lo, glm::vec3 hi, float radius) : lo_(lo), r2_(radius * radius) {
+        glm::vec3 extent = hi - lo;
+        float cell = std::max(radius, 1e-3f);
+        // Cap the cell count for sparse, large regions
+        float maxExtent = std::max({extent.x, extent.y, extent.z});
+        cell = std::max(cell, maxExtent / 128.0f);
+        inv_ = 1.0f / cell;
+        const float e[3] = {extent.x, extent.y, extent.z};
+        for (int d = 0; d < 3; ++d) dim_[d] = std::max(1, static_cast<int>(e[d] * inv_) + 1);
+        head_.assign(static_cast<size_t>(dim_[0]) * dim_[1] * dim_[2], -1);
+    }
+
+    void insert(glm::vec3 p) {
+        int c[3];
+        cellOf(p, c);
+        size_t cell = index(c[0], c[1], c[2]);
+        next_.push_back(head_[cell]);
+        head_[cell] = static_cast<int>(points_.size());
+        points_.push_back(p);
+    }
+
+    bool anyWithin(glm::vec3 p) const {
+        int c[3];
+        cellOf(p, c);
+        for (int x = std::max(c[0] - 1, 0); x <= std::min(c[0] + 1, dim_[0] - 1); ++x)
+        for (int y = std::max(c[1] - 1, 0); y <= std::min(c[1] + 1, dim_[1] - 1); ++y)
+        for (int z = std::max(c[2] - 1, 0); z <= std::min(c[2] + 1, dim_[2] - 1); ++z) {
+            for (int k = head_[index(x, y, z)]; k >= 0; k = next_[k]) {
+                glm::vec3 d = points_[k] - p;
+                if (glm::dot(d, d) < r2_) return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    glm::vec3 lo_;
+    float r2_, inv_;
+    int dim_[3];
+    std::vector<int> head_, next_;     // per-cell linked lists
+    std::vector<glm::vec3> points_;
+
+    void cellOf(glm::vec3 p, int* c) const {
+        glm::vec3 r = (p - lo_) * inv_;
+        const float f[3] = {r.x, r.y, r.z};
+        for (int d = 0; d < 3; ++d)
+            c[d] = std::clamp(static_cast<int>(std::floor(f[d])), 0, dim_[d] - 1);
+    }
+    size_t index(int x, int y, int z) const {
+        return (static_cast<size_t>(z) * dim_[1] + y) * dim_[0] + x;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════
+//  Disordered fills
+// ═══════════════════════════════════════════════════════════
+std::vector<SpawnSpec> gasFill(const std::vector<int>& species, int count,
+                               glm::vec3 lo, glm::vec3 hi, float minSeparation,
+                               std::mt19937& rng) {
+    std::vector<SpawnSpec> out;
+    if (species.empty() || count <= 0) return out;
+    out.reserve(count);
+
+    std::uniform_real_distribution<float> ux(lo.x, hi.x), uy(lo.y, hi.y), uz(lo.z, hi.z);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(species.size()) - 1);
+    PointGrid grid(lo, hi, minSeparation);
+
+    // Rejection sampling; give up once the region is effectively full
+    long long attempts = 0, maxAttempts = 50LL * count;
+    while (static_cast<int>(out.size()) < count && attempts++ < maxAttempts) {
+        glm::vec3 p(ux(rng), uy(rng), uz(rng));
+        if (minSeparation > 0.0f && grid.anyWithin(p)) continue;
+        grid.insert(p);
+        out.push_back({species[pick(rng)], p});
+    }
+    return out;
+}
+
+std::vector<SpawnSpec> waterMolecule() {
+    const float bond = 0.96f;
+    const float half = 0.5f * 104.5f * static_cast<float>(M_PI) / 180.0f;
+    return {{8, glm::vec3(0.0f)},
+            {1, glm::vec3( bond * std::sin(half), bond * std::cos(half), 0.0f)},
+            {1, glm::vec3(-bond * std::sin(half), bond * std::cos(half), 0.0f)}};
+}
+
+std::vector<SpawnSpec> solvatedBox(const std::vector<SpawnSpec>& solute,
+                                   const std::vector<SpawnSpec>& solvent,
+                                   float halfWidth, float spacing, float exclusion,
+                                   std::mt19937& rng) {
+    std::vector<SpawnSpec> out = solute;
+    if (solvent.empty() || spacing <= 0.0f) return out;
+
+    glm::vec3 lo(-halfWidth), hi(halfWidth);
+    PointGrid soluteGrid(lo, hi, exclusion);
+    for (const auto& s : solute) soluteGrid.insert(s.pos);
+
+    int sites = static_cast<int>(2.0f * halfWidth / spacing);
+    out.reserve(solute.size() + static_cast<size_t>(sites) * sites * sites * solvent.size());
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::vector<glm::vec3> placed(solvent.size());
+
+    for (int ix = 0; ix < sites; ++ix)
+    for (int iy = 0; iy < sites; ++iy)
+    for (int iz = 0; iz < sites; ++iz) {
+        glm::vec3 site = lo + spacing * glm::vec3(ix + 0.5f, iy + 0.5f, iz + 0.5f);
+
+        // Uniform random rotation from a normalised Gaussian quaternion;
+        // v' = v + 2w(q × v) + 2q × (q × v)
+        float w = gauss(rng);
+        glm::vec3 q(gauss(rng), gauss(rng), gauss(rng));
+        float norm = std::sqrt(w * w + glm::dot(q, q));
+        if (norm < 1e-6f) { w = 1.0f; q = glm::vec3(0.0f); norm = 1.0f; }
+        w /= norm; q = q / norm;
+
+        bool clear = true;
+        for (size_t k = 0; k < solvent.size() && clear; ++k) {
+            glm::vec3 v = solvent[k].pos - solvent[0].pos;
+            glm::vec3 t = 2.0f * glm::cross(q, v);
+            glm::vec3 p = site + v + w * t + glm::cross(q, t);
+            bool inside = p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y &&
+                          p.z >= lo.z && p.z <= hi.z;
+            clear = inside && (exclusion <= 0.0f || !soluteGrid.anyWithin(p));
+            placed[k] = p;
+        }
+        if (!clear) continue;
+        for (size_t k = 0; k < solvent.size(); ++k)
+            out.push_back({solvent[k].atomicNumber, placed[k]});
+    }
+    return out;
+}
+
+} // namespace physics
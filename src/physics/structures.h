@@ -0,0 +1,51 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+namespace physics {
+
+/// One atom to place: element and position (Å).
+struct SpawnSpec {
+    int atomicNumber = 1;
+    glm::vec3 pos = glm::vec3(0);
+};
+
+// ── Crystal lattices ──
+// `a` is the cubic cell edge (Å); the block of cells is centred on `centre`.
+
+/// Face-centred cubic, 4 atoms per cell (e.g. Cu a = 3.61, Ar a = 5.26).
+std::vector<SpawnSpec> fccLattice(int atomicNumber, float a, glm::ivec3 cells,
+                                  glm::vec3 centre = glm::vec3(0));
+
+/// Body-centred cubic, 2 atoms per cell (e.g. Fe a = 2.87).
+std::vector<SpawnSpec> bccLattice(int atomicNumber, float a, glm::ivec3 cells,
+                                  glm::vec3 centre = glm::vec3(0));
+
+/// Rock salt: interpenetrating cation and anion FCC sublattices, 8 atoms
+/// per cell (e.g. NaCl a = 5.64).
+std::vector<SpawnSpec> rockSaltLattice(int cationZ, int anionZ, float a, glm::ivec3 cells,
+                                       glm::vec3 centre = glm::vec3(0));
+
+// ── Disordered fills ──
+
+/// `count` atoms drawn uniformly from `species`, at uniform random positions
+/// in [lo, hi] with no two closer than minSeparation. Returns fewer atoms if
+/// the region fills up first.
+std::vector<SpawnSpec> gasFill(const std::vector<int>& species, int count,
+                               glm::vec3 lo, glm::vec3 hi, float minSeparation,
+                               std::mt19937& rng);
+
+/// Water with O at the origin (O–H 0.96 Å, H–O–H 104.5°).
+std::vector<SpawnSpec> waterMolecule();
+
+/// Solute plus copies of `solvent` (positions relative to its first atom)
+/// on a cubic grid of the given spacing filling [-halfWidth, halfWidth]³,
+/// each randomly rotated. Sites whose molecule would come within
+/// `exclusion` of a solute atom are left empty.
+std::vector<SpawnSpec> solvatedBox(const std::vector<SpawnSpec>& solute,
+                                   const std::vector<SpawnSpec>& solvent,
+                                   float halfWidth, float spacing, float exclusion,
+                                   std::mt19937& rng);
+
+} // namespace physics
@@ -0,0 +1,77 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace physics {
+
+ThreadPool::~ThreadPool() {
+    resize(1);
+}
+
+void ThreadPool::resize(int threads) {
+    threads = std::max(1, threads);
+    if (threads == size()) return;
+
+    // Stop and join the current workers, then start the new set
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_) t.join();
+    workers_.clear();
+
+    stop_ = false;
+    for (int w = 1; w < threads; ++w)
+        workers_.emplace_back(&ThreadPool::workerLoop, this, w, generation_);
+}
+
+void ThreadPool::drain(const Task& fn, int taskCount, int worker) {
+    for (int t = next_.fetch_add(1); t < taskCount; t = next_.fetch_add(1))
+        fn(t, worker);
+}
+
+void ThreadPool::run(int taskCount, const Task& fn) {
+    if (taskCount <= 0) return;
+    if (workers_.empty() || taskCount == 1) {
+        for (int t = 0; t < taskCount; ++t) fn(t, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &fn;
+        taskCount_ = taskCount;
+        next_.store(0);
+        busy_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    drain(fn, taskCount, 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker, unsigned seen) {
+    for (;;) {
+        const Task* fn;
+        int taskCount;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            fn = task_;
+            taskCount = taskCount_;
+        }
+
+        drain(*fn, taskCount, worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busy_ == 0) done_.notify_one();
+    }
+}
+
+} // namespace physics
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace physics {
+
+/// Minimal fork-join pool. The calling thread takes part as worker 0, so a
+/// pool of size 1 runs everything inline without touching a thread.
+class ThreadPool {
+public:
+    /// fn(task, worker): task in [0, taskCount), worker in [0, size()).
+    using Task = std::function<void(int task, int worker)>;
+
+    ThreadPool() = default;
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Set the total number of workers (including the caller).
+    void resize(int threads);
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /// Run every task once, handing them out dynamically. Blocks until done.
+    void run(int taskCount, const Task& fn);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_, done_;
+
+    const Task* task_ = nullptr;
+    int taskCount_ = 0;
+    std::atomic<int> next_{0};
+    int busy_ = 0;
+    unsigned generation_ = 0;
+    bool stop_ = false;
+
+    void workerLoop(int worker, unsigned seen);
+    void drain(const Task& fn, int taskCount, int worker);
+};
+
+} // namespace physics
@@ -1,7 +1,6 @@
 #include "periodic_table.h"
 #include "../physics/element.h"
 #include <GL/glew.h>
-#include <cstring>
 
 namespace ui {
 
@@ -21,18 +20,20 @@ static const int layout[10][18] = {
 static const int ROWS = 10, COLS = 18;
 
 // Category → color
-static void categoryColor(const char* cat, float& r, float& g, float& b) {
-    if (!cat) { r=0.3f; g=0.3f; b=0.3f; return; }
-    if (strcmp(cat,"nonmetal")==0)              { r=0.2f; g=0.8f; b=0.4f; }
-    else if (strcmp(cat,"noble_gas")==0)        { r=0.4f; g=0.6f; b=0.9f; }
-    else if (strcmp(cat,"alkali_metal")==0)     { r=0.9f; g=0.3f; b=0.5f; }
-    else if (strcmp(cat,"alkaline_earth")==0)   { r=0.9f; g=0.6f; b=0.2f; }
-    else if (strcmp(cat,"transition_metal")==0) { r=0.6f; g=0.5f; b=0.7f; }
-    else if (strcmp(cat,"metalloid")==0)        { r=0.5f; g=0.7f; b=0.5f; }
-    else if (strcmp(cat,"halogen")==0)          { r=0.3f; g=0.9f; b=0.7f; }
-    else if (strcmp(cat,"post_transition_metal")==0) { r=0.6f; g=0.6f; b=0.5f; }
-    else if (strcmp(cat,"actinide")==0)         { r=0.5f; g=0.3f; b=0.8f; }
-    else                                       { r=0.4f; g=0.4f; b=0.4f; }
+static void categoryColor(physics::ElementCategory cat, float& r, float& g, float& b) {
+    using C = physics::ElementCategory;
+    switch (cat) {
+    case C::Nonmetal:            r=0.2f; g=0.8f; b=0.4f; break;
+    case C::NobleGas:            r=0.4f; g=0.6f; b=0.9f; break;
+    case C::AlkaliMetal:         r=0.9f; g=0.3f; b=0.5f; break;
+    case C::AlkalineEarth:       r=0.9f; g=0.6f; b=0.2f; break;
+    case C::TransitionMetal:     r=0.6f; g=0.5f; b=0.7f; break;
+    case C::Metalloid:           r=0.5f; g=0.7f; b=0.5f; break;
+    case C::Halogen:             r=0.3f; g=0.9f; b=0.7f; break;
+    case C::PostTransitionMetal: r=0.6f; g=0.6f; b=0.5f; break;
+    case C::Actinide:            r=0.5f; g=0.3f; b=0.8f; break;
+    default:                     r=0.4f; g=0.4f; b=0.4f; break;
+    }
 }
 
 void PeriodicTableUI::drawCell(float x, float y, float w, float h,
@@ -76,7 +77,7 @@ void PeriodicTableUI::render(int windowW, int windowH) {
             if (el.atomicNumber == 0) continue;
 
             float r, g, b;
-            categoryColor(el.category.c_str(), r, g, b);
+            categoryColor(el.category, r, g, b);
             float x = startX + col * cellW;
             float y = startY + row * cellH;
             drawCell(x, y, cellW - 1, cellH - 1, z, el.symbol.c_str(), r, g, b);